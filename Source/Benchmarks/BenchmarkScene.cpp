@@ -0,0 +1,282 @@
+#include "BenchmarkScene.hpp"
+
+
+// STL headers.
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+
+// Engine headers.
+#include <Utility/Misc.hpp>
+#include <Utility/RNG.hpp>
+
+
+// Engine namespace.
+namespace water
+{
+    ///////////////////////
+    /// BenchmarkObject ///
+    ///////////////////////
+
+    BenchmarkObject::BenchmarkObject (const Rectangle<float>& box, const bool isCircle, const unsigned int layer, const bool isTrigger,
+                                      const bool isStatic, const Vector2<float>& position, const Vector2<float>& velocity,
+                                      BenchmarkScene& scene, const unsigned int id)
+        : m_scene (&scene), m_id (id)
+    {
+        const auto radius = util::min (box.getRight() - box.getLeft(), box.getBottom() - box.getTop()) / 2.f;
+
+        if (isCircle)
+        {
+            m_collider.setCircle ({ box.getLeft() + radius, box.getTop() + radius }, radius);
+        }
+
+        else
+        {
+            m_collider.setBox (box);
+        }
+
+        m_collider.setLayer (layer);
+        m_collider.setTrigger (isTrigger);
+        m_isStatic  = isStatic;
+        m_position  = position;
+        m_velocity  = isStatic ? Vector2<float> { 0.f, 0.f } : velocity;
+    }
+
+
+    void BenchmarkObject::move (const Rectangle<float>& bounds, const float delta)
+    {
+        m_position += m_velocity * delta;
+
+        // Turn around rather than leave the world so the density of the scene stays the same.
+        if ((m_position.x < bounds.getLeft() && m_velocity.x < 0.f) || (m_position.x > bounds.getRight() && m_velocity.x > 0.f))
+        {
+            m_velocity.x = -m_velocity.x;
+        }
+
+        if ((m_position.y < bounds.getTop() && m_velocity.y < 0.f) || (m_position.y > bounds.getBottom() && m_velocity.y > 0.f))
+        {
+            m_velocity.y = -m_velocity.y;
+        }
+    }
+
+
+    ////////////////////////////////////
+    /// BenchmarkScene: Constructors ///
+    ////////////////////////////////////
+
+    BenchmarkScene::BenchmarkScene (const SceneType type, const unsigned int count, const unsigned int seed, const unsigned int circles)
+    {
+        // Pre-condition: There is something to generate.
+        if (count == 0)
+        {
+            throw std::invalid_argument ("BenchmarkScene::BenchmarkScene(), count must not be zero.");
+        }
+
+        m_owned.reserve (count);
+        m_objects.reserve (count);
+
+        // Each object is given roughly the same amount of space regardless of the scene, so only the distribution changes.
+        const auto side = std::sqrt ((float) count) * 40.f;
+
+        util::RNG<float>            unit    { 0.f, 1.f, seed };
+        util::RNG<float>            size    { 4.f, 24.f, seed + 1 };
+        util::RNG<float>            speed   { -60.f, 60.f, seed + 2 };
+        util::RNG<unsigned int>     layer   { 0, 3, seed + 3 };
+        util::RNG<unsigned int>     percent { 0, 99, seed + 4 };
+
+        // A tenth of the objects are triggers in every scene. Shapes are only drawn when asked for so scenes without circles are
+        // identical to those generated before circles existed.
+        const auto random = [&] (const bool isStatic, const Vector2<float>& position, const Vector2<float>& velocity)
+        {
+            const auto box      = Rectangle<float> { 0.f, 0.f, size(), size() };
+            const auto isCircle = circles != 0 && percent() < circles;
+
+            add (box, isCircle, layer(), percent() < 10, isStatic, position, velocity);
+        };
+
+        switch (type)
+        {
+            case SceneType::Uniform:
+            {
+                m_bounds = { 0.f, 0.f, side, side };
+
+                for (auto i = 0U; i < count; ++i)
+                {
+                    random (percent() < 25, { unit() * side, unit() * side }, { speed(), speed() });
+                }
+
+                break;
+            }
+
+            case SceneType::Clustered:
+            {
+                // A handful of points with objects normally distributed around them.
+                std::default_random_engine      engine  { seed + 5 };
+                std::normal_distribution<float> offset  { 0.f, side / 40.f };
+                std::vector<Vector2<float>>     centres { 16 };
+
+                m_bounds = { 0.f, 0.f, side, side };
+
+                for (auto& centre : centres)
+                {
+                    centre = { unit() * side, unit() * side };
+                }
+
+                for (auto i = 0U; i < count; ++i)
+                {
+                    const auto& centre = centres[i % centres.size()];
+                    random (percent() < 25, { centre.x + offset (engine), centre.y + offset (engine) }, { speed(), speed() });
+                }
+
+                break;
+            }
+
+            case SceneType::Corridor:
+            {
+                // Walls are made of 32 unit segments along the top and bottom, everything else travels along the corridor.
+                const auto height   = 256.f;
+                const auto length   = (float) count * 1600.f / height;
+                const auto walls    = util::min (count / 10, (unsigned int) (length / 32.f) * 2);
+
+                m_bounds = { 0.f, 0.f, length, height };
+
+                for (auto i = 0U; i < walls; ++i)
+                {
+                    add ({ 0.f, 0.f, 32.f, 8.f }, false, 0, false, true, { (float) (i / 2) * 32.f, i % 2 == 0 ? -8.f : height }, { });
+                }
+
+                for (auto i = walls; i < count; ++i)
+                {
+                    random (false, { unit() * length, unit() * height }, { speed() * 4.f, speed() * 0.25f });
+                }
+
+                break;
+            }
+
+            case SceneType::MostlyStatic:
+            {
+                // Nine in every ten objects form a grid of tiles.
+                const auto tiles    = count - count / 10;
+                const auto columns  = (unsigned int) std::ceil (std::sqrt ((float) tiles));
+                const auto spacing  = side / (float) columns;
+
+                m_bounds = { 0.f, 0.f, side, side };
+
+                for (auto i = 0U; i < tiles; ++i)
+                {
+                    random (true, { (float) (i % columns) * spacing, (float) (i / columns) * spacing }, { });
+                }
+
+                for (auto i = tiles; i < count; ++i)
+                {
+                    random (false, { unit() * side, unit() * side }, { speed(), speed() });
+                }
+
+                break;
+            }
+
+            case SceneType::Swept:
+            {
+                // Still circles are staggered so diagonal neighbours overlap as boxes but are just under a unit apart as circles. Fast
+                // continuous boxes cross them, so circle pairs share candidate groups with colliders which have to be swept.
+                const auto circles  = count - count / 10;
+                const auto columns  = (unsigned int) std::ceil (std::sqrt ((float) circles));
+                const auto rows     = (circles + columns - 1) / columns;
+
+                m_bounds = { 0.f, 0.f, (float) columns * 24.f, (float) rows * 12.f };
+
+                for (auto i = 0U; i < circles; ++i)
+                {
+                    const auto row = i / columns;
+                    add ({ 0.f, 0.f, 16.f, 16.f }, true, 0, false, false, { (float) (i % columns) * 24.f + (float) (row % 2) * 12.f,
+                                                                            (float) row * 12.f }, { });
+                }
+
+                for (auto i = circles; i < count; ++i)
+                {
+                    add ({ 0.f, 0.f, 8.f, 8.f }, false, 0, false, false, { unit() * m_bounds.getRight(), unit() * m_bounds.getBottom() },
+                         { speed() * 8.f, speed() * 8.f }, true);
+                }
+
+                break;
+            }
+        }
+    }
+
+
+    ///////////////////////////////
+    /// BenchmarkScene: Running ///
+    ///////////////////////////////
+
+    void BenchmarkScene::applyLayerMasks (IPhysics& physics)
+    {
+        // The fourth layer acts like effects which only interact with the first layer and each other.
+        physics.setLayerMask (3, (1U << 0) | (1U << 3));
+    }
+
+
+    void BenchmarkScene::update (const float delta)
+    {
+        for (auto object : m_dynamic)
+        {
+            object->move (m_bounds, delta);
+        }
+    }
+
+
+    /////////////////////////////////
+    /// BenchmarkScene: Utilities ///
+    /////////////////////////////////
+
+    std::string BenchmarkScene::getName (const SceneType type)
+    {
+        switch (type)
+        {
+            case SceneType::Uniform:        return "uniform";
+            case SceneType::Clustered:      return "clustered";
+            case SceneType::Corridor:       return "corridor";
+            case SceneType::MostlyStatic:   return "mostly-static";
+            case SceneType::Swept:          return "swept";
+        }
+
+        return "";
+    }
+
+
+    bool BenchmarkScene::parse (const std::string& name, SceneType& type)
+    {
+        const auto lower = util::toLower (name);
+
+        for (const auto candidate : { SceneType::Uniform, SceneType::Clustered, SceneType::Corridor, SceneType::MostlyStatic,
+                                      SceneType::Swept })
+        {
+            if (lower == getName (candidate))
+            {
+                type = candidate;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+
+    /////////////////////////////////////////
+    /// BenchmarkScene: Internal workings ///
+    /////////////////////////////////////////
+
+    void BenchmarkScene::add (const Rectangle<float>& box, const bool isCircle, const unsigned int layer, const bool isTrigger,
+                              const bool isStatic, const Vector2<float>& position, const Vector2<float>& velocity, const bool isContinuous)
+    {
+        const auto id = (unsigned int) m_owned.size();
+        m_owned.emplace_back (new BenchmarkObject (box, isCircle, layer, isTrigger, isStatic, position, velocity, *this, id));
+        m_owned.back()->setContinuous (isContinuous);
+        m_objects.push_back (m_owned.back().get());
+
+        if (!isStatic)
+        {
+            m_dynamic.push_back (m_owned.back().get());
+        }
+    }
+}
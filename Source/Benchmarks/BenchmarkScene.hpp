@@ -0,0 +1,254 @@
+#if !defined WATER_BENCHMARK_SCENE_INCLUDED
+#define WATER_BENCHMARK_SCENE_INCLUDED
+
+
+// STL headers.
+#include <memory>
+#include <string>
+#include <vector>
+
+
+// Engine headers.
+#include <GameComponents/PhysicsObject.hpp>
+#include <Interfaces/IPhysics.hpp>
+#include <Misc/Rectangle.hpp>
+
+
+// Engine namespace.
+namespace water
+{
+    // Forward declarations.
+    class BenchmarkScene;
+
+
+    /// <summary> The kinds of callback which a BenchmarkObject can receive. </summary>
+    enum class Callback : int
+    {
+        Collision       = 0,
+        Trigger         = 1,
+        CollisionExit   = 2,
+        TriggerExit     = 3
+    };
+
+
+    /// <summary> A single callback received by an object, objects are identified by the order the scene generated them in. </summary>
+    struct CallbackEvent final
+    {
+        unsigned int    object  { 0 };                      //!< The object which received the callback.
+        unsigned int    other   { 0 };                      //!< The object it was about.
+        Callback        type    { Callback::Collision };    //!< Which callback was received.
+
+        bool operator== (const CallbackEvent& rhs) const    { return object == rhs.object && other == rhs.other && type == rhs.type; }
+        bool operator!= (const CallbackEvent& rhs) const    { return !(*this == rhs); }
+    };
+
+
+    /// <summary>
+    /// A physics object which does nothing but report the callbacks it receives to its scene, used to build headless benchmark scenes.
+    /// </summary>
+    class BenchmarkObject final : public PhysicsObject
+    {
+        public:
+
+            ///////////////////////////////////
+            /// Constructors and destructor ///
+            ///////////////////////////////////
+
+            /// <summary> Creates an object with the given collider and motion. </summary>
+            /// <param name="box"> The local box of the collider. </param>
+            /// <param name="isCircle"> Whether the collider is the largest circle which fits inside the box. </param>
+            /// <param name="layer"> The collision layer of the object. </param>
+            /// <param name="isTrigger"> Whether the collider is a trigger. </param>
+            /// <param name="isStatic"> Whether the object is static. </param>
+            /// <param name="position"> The starting position of the object. </param>
+            /// <param name="velocity"> How far the object moves each second, ignored for static objects. </param>
+            /// <param name="scene"> The scene to report callbacks to, this must outlive the object. </param>
+            /// <param name="id"> The position of the object in the scene. </param>
+            BenchmarkObject (const Rectangle<float>& box, const bool isCircle, const unsigned int layer, const bool isTrigger,
+                             const bool isStatic, const Vector2<float>& position, const Vector2<float>& velocity,
+                             BenchmarkScene& scene, const unsigned int id);
+
+            BenchmarkObject (const BenchmarkObject& copy)               = delete;
+            BenchmarkObject& operator= (const BenchmarkObject& copy)    = delete;
+            ~BenchmarkObject() override final                           { }
+
+
+            ////////////////////
+            /// Game objects ///
+            ////////////////////
+
+            /// <summary> Obtains the position of the object in its scene. </summary>
+            unsigned int getID() const                                  { return m_id; }
+
+            bool initialise() override final                            { return true; }
+            void updatePhysics() override final                         { }
+            void update() override final                                { }
+            void render() override final                                { }
+
+
+            /////////////////
+            /// Collision ///
+            /////////////////
+
+            void onCollision (PhysicsObject* const other) override final;
+            void onTrigger (PhysicsObject* const other) override final;
+            void onCollisionExit (PhysicsObject* const other) override final;
+            void onTriggerExit (PhysicsObject* const other) override final;
+
+
+            ////////////////
+            /// Movement ///
+            ////////////////
+
+            /// <summary> Moves the object by its velocity, bouncing off the edges of the given bounds. </summary>
+            /// <param name="bounds"> The area the object must stay within. </param>
+            /// <param name="delta"> The length of the update in seconds. </param>
+            void move (const Rectangle<float>& bounds, const float delta);
+
+        private:
+
+            ///////////////////////////
+            /// Implementation data ///
+            ///////////////////////////
+
+            BenchmarkScene* m_scene { nullptr };    //!< The scene which owns the object.
+            unsigned int    m_id    { 0 };          //!< The position of the object in the scene.
+    };
+
+
+    /// <summary> The distributions of objects which a BenchmarkScene can generate. </summary>
+    enum class SceneType : int
+    {
+        Uniform         = 0,    //!< Objects are scattered evenly over a square world, a quarter of them are static.
+        Clustered       = 1,    //!< Objects are bunched around a handful of points, producing dense hot spots.
+        Corridor        = 2,    //!< A long, thin world lined with static walls which objects travel along.
+        MostlyStatic    = 3,    //!< A grid of static tiles with a tenth of the objects moving through it.
+        Swept           = 4     //!< Circles which nearly touch diagonally with a tenth of the objects being fast continuous boxes.
+    };
+
+
+    /// <summary>
+    /// Generates a deterministic scene of physics objects for benchmarking the physics system without a window or any other system.
+    /// Most scenes mix triggers and four layers, where the fourth layer only collides with itself and the first. Objects are owned
+    /// by the scene, which must stay where it is while they exist as they point back to its callback counter.
+    /// </summary>
+    class BenchmarkScene final
+    {
+        public:
+
+            ///////////////////////////////////
+            /// Constructors and destructor ///
+            ///////////////////////////////////
+
+            /// <summary> Generates a scene. </summary>
+            /// <param name="type"> The distribution of objects to generate. </param>
+            /// <param name="count"> The number of objects to generate. Must not be zero. </param>
+            /// <param name="seed"> The seed of the random number generators, the same seed always generates the same scene. </param>
+            /// <param name="circles"> The percentage of randomly sized objects which are circles rather than boxes. </param>
+            BenchmarkScene (const SceneType type, const unsigned int count, const unsigned int seed, const unsigned int circles = 0);
+
+            BenchmarkScene (const BenchmarkScene& copy)             = delete;
+            BenchmarkScene& operator= (const BenchmarkScene& copy)  = delete;
+            BenchmarkScene (BenchmarkScene&& move)                  = delete;
+            BenchmarkScene& operator= (BenchmarkScene&& move)       = delete;
+            ~BenchmarkScene()                                       = default;
+
+
+            ///////////////////////////
+            /// Getters and setters ///
+            ///////////////////////////
+
+            /// <summary> Obtains every object in the scene, ready to be given to the physics system. </summary>
+            const std::vector<PhysicsObject*>& getObjects() const   { return m_objects; }
+
+            /// <summary> Obtains the number of callbacks the objects have received since the counter was last reset. </summary>
+            unsigned long long getCallbacks() const                 { return m_callbacks; }
+
+            /// <summary> Resets the callback counter. </summary>
+            void resetCallbacks()                                   { m_callbacks = 0; }
+
+            /// <summary> Obtains the callbacks recorded since they were last cleared, in the order they were received. </summary>
+            const std::vector<CallbackEvent>& getEvents() const     { return m_events; }
+
+            /// <summary> Discards the recorded callbacks. </summary>
+            void clearEvents()                                      { m_events.clear(); }
+
+            /// <summary> Sets whether each callback should be recorded as well as counted. Recording is off by default. </summary>
+            void setRecording (const bool recording)                { m_recording = recording; }
+
+
+            ///////////////
+            /// Running ///
+            ///////////////
+
+            /// <summary> Sets the layer masks which the scene was designed for. </summary>
+            static void applyLayerMasks (IPhysics& physics);
+
+            /// <summary> Moves every dynamic object by its velocity, keeping them within the world. </summary>
+            /// <param name="delta"> The length of the update in seconds. </param>
+            void update (const float delta);
+
+
+            /////////////////
+            /// Utilities ///
+            /////////////////
+
+            /// <summary> Obtains the name of a scene type, as used on the command line and in results. </summary>
+            static std::string getName (const SceneType type);
+
+            /// <summary> Finds the scene type with the given name. </summary>
+            /// <returns> Whether the name was valid, if not the type is left untouched. </returns>
+            static bool parse (const std::string& name, SceneType& type);
+
+        private:
+
+            // Objects report their callbacks through record().
+            friend class BenchmarkObject;
+
+
+            /////////////////////////
+            /// Internal workings ///
+            /////////////////////////
+
+            /// <summary> Counts a callback, also recording it if recording is on. </summary>
+            void record (const BenchmarkObject& object, const PhysicsObject* const other, const Callback type);
+
+            /// <summary> Creates an object and adds it to the scene. </summary>
+            void add (const Rectangle<float>& box, const bool isCircle, const unsigned int layer, const bool isTrigger, const bool isStatic,
+                      const Vector2<float>& position, const Vector2<float>& velocity, const bool isContinuous = false);
+
+
+            ///////////////////////////
+            /// Implementation data ///
+            ///////////////////////////
+
+            std::vector<std::unique_ptr<BenchmarkObject>>   m_owned     { };          //!< The objects in the scene.
+            std::vector<PhysicsObject*>                     m_objects   { };          //!< The objects in the scene, in the form the physics system takes.
+            std::vector<BenchmarkObject*>                   m_dynamic   { };          //!< The objects which move each update.
+            Rectangle<float>                                m_bounds    { };          //!< The area which dynamic objects must stay within.
+            std::vector<CallbackEvent>                      m_events    { };          //!< The callbacks received since the events were cleared.
+            unsigned long long                              m_callbacks { 0 };        //!< The number of callbacks received by every object.
+            bool                                            m_recording { false };    //!< Whether callbacks are recorded as well as counted.
+    };
+
+
+    // Callbacks are defined here so they're inlined into the physics system like any other object's.
+    inline void BenchmarkObject::onCollision (PhysicsObject* const other)       { m_scene->record (*this, other, Callback::Collision); }
+    inline void BenchmarkObject::onTrigger (PhysicsObject* const other)         { m_scene->record (*this, other, Callback::Trigger); }
+    inline void BenchmarkObject::onCollisionExit (PhysicsObject* const other)   { m_scene->record (*this, other, Callback::CollisionExit); }
+    inline void BenchmarkObject::onTriggerExit (PhysicsObject* const other)     { m_scene->record (*this, other, Callback::TriggerExit); }
+
+
+    inline void BenchmarkScene::record (const BenchmarkObject& object, const PhysicsObject* const other, const Callback type)
+    {
+        ++m_callbacks;
+
+        // Every object in a scene is a BenchmarkObject.
+        if (m_recording)
+        {
+            m_events.push_back ({ object.getID(), static_cast<const BenchmarkObject*> (other)->getID(), type });
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,426 @@
+// STL headers.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+// Engine headers.
+#include <Benchmarks/BenchmarkScene.hpp>
+#include <Systems/Physics/Physics.hpp>
+#include <Utility/JobSystem.hpp>
+
+
+// Engine namespace.
+using namespace water;
+
+
+/// <summary> Everything which can be changed from the command line. </summary>
+struct Options final
+{
+    std::vector<SceneType>      scenes  { SceneType::Uniform, SceneType::Clustered, SceneType::Corridor, SceneType::MostlyStatic, SceneType::Swept };
+    std::vector<unsigned int>   counts  { 1000, 10000, 50000 };
+    unsigned int                steps   { 100 };    //!< The number of measured updates of each scene.
+    unsigned int                warmup  { 10 };     //!< The number of updates run before measuring, letting the trees settle.
+    unsigned int                threads { 1 };      //!< The number of threads given to the physics system.
+    unsigned int                seed    { 1 };      //!< The seed used to generate every scene.
+    unsigned int                circles { 0 };      //!< The percentage of randomly sized objects which are circles.
+    float                       margin  { 4.f };    //!< The margin of the broadphase trees.
+    std::string                 csv     { };        //!< Where to write machine-readable results, "-" means standard output.
+    std::vector<unsigned int>   verify  { };        //!< Thread counts whose callbacks are compared instead of measuring anything.
+};
+
+
+/// <summary> The averaged measurements of a single scene. </summary>
+struct Result final
+{
+    SceneType       scene       { };
+    unsigned int    objects     { 0 };
+    unsigned int    threads     { 0 };      //!< The number of threads the physics system used, never zero.
+    double          update      { 0.0 };    //!< Milliseconds per update.
+    double          perObject   { 0.0 };    //!< Nanoseconds per object per update.
+    double          tested      { 0.0 };    //!< Candidate pairs tested per update.
+    double          overlapping { 0.0 };    //!< Overlapping pairs per update.
+    double          callbacks   { 0.0 };    //!< Callbacks fired per update.
+    double          broadphase  { 0.0 };    //!< Milliseconds per update spent in the broadphase, as measured by the physics system.
+    double          narrowphase { 0.0 };    //!< Milliseconds per update spent in the narrowphase.
+    double          dispatch    { 0.0 };    //!< Milliseconds per update spent tracking contacts and calling events.
+};
+
+
+/// <summary> Prints how the benchmark should be used. </summary>
+static void printUsage()
+{
+    std::cout << "Usage: PhysicsBenchmark [options]\n"
+                 "  --scenes a,b,...    uniform, clustered, corridor, mostly-static, swept or all (default all)\n"
+                 "  --objects n,m,...   object counts to test (default 1000,10000,50000)\n"
+                 "  --steps n           measured updates per scene (default 100)\n"
+                 "  --warmup n          updates before measuring (default 10)\n"
+                 "  --threads n         physics threads, 0 uses every hardware thread (default 1)\n"
+                 "  --seed n            scene generation seed (default 1)\n"
+                 "  --margin n          broadphase margin (default 4)\n"
+                 "  --circles n         percentage of objects which are circles (default 0)\n"
+                 "  --csv path          also write results as CSV, - for standard output\n"
+                 "  --verify a,b,...    check these thread counts give the same callbacks in the same order instead of measuring\n";
+}
+
+
+/// <summary> Splits a comma separated list. </summary>
+static std::vector<std::string> split (const std::string& list)
+{
+    std::vector<std::string> items { };
+    auto start = (size_t) 0;
+
+    while (start <= list.size())
+    {
+        const auto end = util::min (list.find (',', start), list.size());
+        items.push_back (list.substr (start, end - start));
+        start = end + 1;
+    }
+
+    return items;
+}
+
+
+/// <summary> Reads the command line, throwing std::invalid_argument if anything isn't understood. </summary>
+static Options parseOptions (const int argc, char** const argv)
+{
+    Options options { };
+
+    for (auto i = 1; i < argc; ++i)
+    {
+        const std::string option = argv[i];
+
+        // Every option takes a value.
+        if (i + 1 >= argc)
+        {
+            throw std::invalid_argument ("Missing value for " + option + ".");
+        }
+
+        const std::string value = argv[++i];
+
+        if (option == "--scenes")
+        {
+            if (value != "all")
+            {
+                options.scenes.clear();
+
+                for (const auto& name : split (value))
+                {
+                    auto type = SceneType::Uniform;
+
+                    if (!BenchmarkScene::parse (name, type))
+                    {
+                        throw std::invalid_argument ("Unknown scene " + name + ".");
+                    }
+
+                    options.scenes.push_back (type);
+                }
+            }
+        }
+
+        else if (option == "--objects")
+        {
+            options.counts.clear();
+
+            for (const auto& count : split (value))
+            {
+                options.counts.push_back ((unsigned int) std::stoul (count));
+            }
+        }
+
+        else if (option == "--steps")   { options.steps     = (unsigned int) std::stoul (value); }
+        else if (option == "--warmup")  { options.warmup    = (unsigned int) std::stoul (value); }
+        else if (option == "--threads") { options.threads   = (unsigned int) std::stoul (value); }
+        else if (option == "--seed")    { options.seed      = (unsigned int) std::stoul (value); }
+        else if (option == "--margin")  { options.margin    = std::stof (value); }
+        else if (option == "--circles") { options.circles   = (unsigned int) std::stoul (value); }
+        else if (option == "--csv")     { options.csv       = value; }
+
+        else if (option == "--verify")
+        {
+            for (const auto& threads : split (value))
+            {
+                options.verify.push_back ((unsigned int) std::stoul (threads));
+            }
+        }
+
+        else
+        {
+            throw std::invalid_argument ("Unknown option " + option + ".");
+        }
+    }
+
+    if (options.steps == 0)
+    {
+        throw std::invalid_argument ("--steps must not be zero.");
+    }
+
+    if (options.verify.size() == 1)
+    {
+        throw std::invalid_argument ("--verify needs at least two thread counts to compare.");
+    }
+
+    return options;
+}
+
+
+/// <summary> Generates a scene and measures how long the physics system takes to update it. </summary>
+static Result run (const Options& options, const SceneType type, const unsigned int count)
+{
+    const auto      delta   = 1.f / 60.f;
+    BenchmarkScene  scene   { type, count, options.seed, options.circles };
+    util::JobSystem jobs    { options.threads };
+    Physics         physics { };
+    Result          result  { };
+
+    physics.initialise (options.margin, &jobs);
+    BenchmarkScene::applyLayerMasks (physics);
+
+    for (auto i = 0U; i < options.warmup; ++i)
+    {
+        scene.update (delta);
+        physics.detectCollisions (scene.getObjects(), delta);
+    }
+
+    // Only the physics update is timed, moving the objects is the job of the game.
+    auto elapsed = std::chrono::steady_clock::duration::zero();
+    scene.resetCallbacks();
+
+    for (auto i = 0U; i < options.steps; ++i)
+    {
+        scene.update (delta);
+
+        const auto start = std::chrono::steady_clock::now();
+        physics.detectCollisions (scene.getObjects(), delta);
+        elapsed += std::chrono::steady_clock::now() - start;
+
+        const auto& stats = physics.getStats();
+
+        result.tested       += stats.candidatePairs;
+        result.overlapping  += stats.overlaps;
+        result.broadphase   += stats.broadphaseTime * 1e3;
+        result.narrowphase  += stats.narrowphaseTime * 1e3;
+        result.dispatch     += stats.dispatchTime * 1e3;
+    }
+
+    const auto nanoseconds = (double) std::chrono::duration_cast<std::chrono::nanoseconds> (elapsed).count() / options.steps;
+
+    result.scene        = type;
+    result.objects      = count;
+    result.threads      = physics.getThreadCount();
+    result.update       = nanoseconds / 1e6;
+    result.perObject    = nanoseconds / count;
+    result.tested      /= options.steps;
+    result.overlapping /= options.steps;
+    result.callbacks    = (double) scene.getCallbacks() / options.steps;
+    result.broadphase  /= options.steps;
+    result.narrowphase /= options.steps;
+    result.dispatch    /= options.steps;
+
+    return result;
+}
+
+
+/// <summary>
+/// Checks whether two objects really touch, using their exact shapes where they are now. A little tolerance is given so pairs which
+/// only just touch aren't rejected because of rounding.
+/// </summary>
+static bool touches (const PhysicsObject& a, const PhysicsObject& b)
+{
+    const auto& colliderA   = a.getCollider();
+    const auto& colliderB   = b.getCollider();
+    auto        boxA        = colliderA.getBox();
+    auto        boxB        = colliderB.getBox();
+    const auto  radiusA     = colliderA.getShape() == ColliderShape::Circle ? colliderA.getRadius() : 0.f;
+    const auto  radiusB     = colliderB.getShape() == ColliderShape::Circle ? colliderB.getRadius() : 0.f;
+
+    boxA.translate (a.getPosition().x, a.getPosition().y);
+    boxB.translate (b.getPosition().x, b.getPosition().y);
+
+    // Shrinking each box by its radius leaves a circle's centre or a box unchanged, they touch if the shrunk shapes are close enough.
+    const auto gapX = util::max (util::max (boxA.getLeft() + radiusA - boxB.getRight() + radiusB,
+                                            boxB.getLeft() + radiusB - boxA.getRight() + radiusA), 0.f);
+    const auto gapY = util::max (util::max (boxA.getTop() + radiusA - boxB.getBottom() + radiusB,
+                                            boxB.getTop() + radiusB - boxA.getBottom() + radiusA), 0.f);
+
+    // Positions far from the origin lose precision, so the tolerance grows with them.
+    const auto magnitude    = util::max (util::max (std::abs (boxA.getLeft()), std::abs (boxA.getRight())),
+                                         util::max (std::abs (boxA.getTop()), std::abs (boxA.getBottom())));
+    const auto sum          = radiusA + radiusB + util::max (1e-3f, magnitude * 1e-6f);
+
+    return gapX * gapX + gapY * gapY <= sum * sum;
+}
+
+
+/// <summary>
+/// Updates a copy of the scene for each thread count side by side, checking that every update gives each copy the same callbacks in the
+/// same order. Every collision and trigger between objects which aren't continuous must also really touch, so contacts can't depend on
+/// how the candidates were grouped. The first difference is reported.
+/// </summary>
+/// <returns> Whether every thread count agreed. </returns>
+static bool verify (const Options& options, const SceneType type, const unsigned int count)
+{
+    const auto                                      delta   = 1.f / 60.f;
+    std::vector<std::unique_ptr<BenchmarkScene>>    scenes  { };
+    std::vector<std::unique_ptr<util::JobSystem>>   jobs    { };
+    std::vector<std::unique_ptr<Physics>>           systems { };
+
+    for (const auto threads : options.verify)
+    {
+        scenes.emplace_back (new BenchmarkScene { type, count, options.seed, options.circles });
+        scenes.back()->setRecording (true);
+
+        jobs.emplace_back (new util::JobSystem { threads });
+        systems.emplace_back (new Physics { });
+        systems.back()->initialise (options.margin, jobs.back().get());
+        BenchmarkScene::applyLayerMasks (*systems.back());
+    }
+
+    const auto  name    = BenchmarkScene::getName (type);
+    auto        total   = 0ULL;
+
+    for (auto step = 0U; step < options.warmup + options.steps; ++step)
+    {
+        for (size_t i = 0; i < scenes.size(); ++i)
+        {
+            scenes[i]->clearEvents();
+            scenes[i]->update (delta);
+            systems[i]->detectCollisions (scenes[i]->getObjects(), delta);
+        }
+
+        const auto& expected    = scenes.front()->getEvents();
+        const auto& objects     = scenes.front()->getObjects();
+
+        for (const auto& event : expected)
+        {
+            const auto& object  = *objects[event.object];
+            const auto& other   = *objects[event.other];
+            const auto  isExit  = event.type == Callback::CollisionExit || event.type == Callback::TriggerExit;
+
+            if (!isExit && !object.isContinuous() && !other.isContinuous() && !touches (object, other))
+            {
+                std::printf ("%-14s %9u   FAILED at update %u, objects %u and %u were reported touching but are apart\n", name.c_str(), count,
+                             step, event.object, event.other);
+                return false;
+            }
+        }
+
+        for (size_t i = 1; i < scenes.size(); ++i)
+        {
+            const auto& events  = scenes[i]->getEvents();
+            const auto  first   = std::mismatch (expected.begin(), expected.end(), events.begin(), events.end()).first - expected.begin();
+
+            if (events.size() != expected.size() || (size_t) first != expected.size())
+            {
+                std::printf ("%-14s %9u   FAILED at update %u, %u threads gave %zu callbacks and %u threads gave %zu, first difference at %zu\n",
+                             name.c_str(), count, step, options.verify.front(), expected.size(), options.verify[i], events.size(),
+                             (size_t) first);
+                return false;
+            }
+        }
+
+        total += expected.size();
+    }
+
+    std::printf ("%-14s %9u   identical, %llu callbacks over %u updates\n", name.c_str(), count, total, options.warmup + options.steps);
+    std::fflush (stdout);
+
+    return true;
+}
+
+
+/// <summary> Writes results as CSV, one row per scene, so they can be compared between builds. </summary>
+static void writeCSV (std::ostream& stream, const Options& options, const std::vector<Result>& results)
+{
+    stream << "scene,objects,threads,steps,seed,ms_per_update,ns_per_object,pairs_tested,pairs_overlapping,callbacks,"
+              "broadphase_ms,narrowphase_ms,dispatch_ms\n";
+
+    for (const auto& result : results)
+    {
+        stream << BenchmarkScene::getName (result.scene) << ',' << result.objects << ',' << result.threads << ',' << options.steps << ','
+               << options.seed << ',' << result.update << ',' << result.perObject << ',' << result.tested << ',' << result.overlapping << ','
+               << result.callbacks << ',' << result.broadphase << ',' << result.narrowphase << ',' << result.dispatch << '\n';
+    }
+}
+
+
+int main (int argc, char** argv)
+{
+    if (argc == 2 && (std::string (argv[1]) == "--help" || std::string (argv[1]) == "-h"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    try
+    {
+        const auto options = parseOptions (argc, argv);
+        std::vector<Result> results { };
+
+        // Verifying replaces measuring, a failure is reported through the exit code.
+        if (!options.verify.empty())
+        {
+            auto isIdentical = true;
+
+            for (const auto scene : options.scenes)
+            {
+                for (const auto count : options.counts)
+                {
+                    isIdentical = verify (options, scene, count) && isIdentical;
+                }
+            }
+
+            return isIdentical ? 0 : 1;
+        }
+
+        std::printf ("%-14s %9s %12s %12s %14s %14s %12s %10s %10s %10s\n", "scene", "objects", "ms/update", "ns/object", "pairs tested",
+                     "overlapping", "callbacks", "broad ms", "narrow ms", "events ms");
+
+        for (const auto scene : options.scenes)
+        {
+            for (const auto count : options.counts)
+            {
+                results.push_back (run (options, scene, count));
+
+                const auto& result = results.back();
+                std::printf ("%-14s %9u %12.3f %12.1f %14.0f %14.0f %12.0f %10.3f %10.3f %10.3f\n", BenchmarkScene::getName (scene).c_str(),
+                             count, result.update, result.perObject, result.tested, result.overlapping, result.callbacks, result.broadphase,
+                             result.narrowphase, result.dispatch);
+                std::fflush (stdout);
+            }
+        }
+
+        if (options.csv == "-")
+        {
+            writeCSV (std::cout, options, results);
+        }
+
+        else if (!options.csv.empty())
+        {
+            std::ofstream file { options.csv };
+
+            if (!file)
+            {
+                throw std::runtime_error ("Unable to open " + options.csv + ".");
+            }
+
+            writeCSV (file, options, results);
+        }
+    }
+
+    catch (const std::exception& error)
+    {
+        std::cerr << error.what() << "\n\n";
+        printUsage();
+        return 1;
+    }
+
+    return 0;
+}
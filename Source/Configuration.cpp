@@ -45,7 +45,10 @@ namespace water
             // Obtain initialisation information.
             const auto settings             = root.child ("Settings");
             const auto audio                = settings.child ("Audio");
+            const auto jobs                 = settings.child ("Jobs");
             const auto logger               = settings.child ("Logger");
+            const auto physics              = settings.child ("Physics");
+            const auto profiler             = settings.child ("Profiler");
             const auto renderer             = settings.child ("Renderer");
             const auto time                 = settings.child ("Time");
 
@@ -58,17 +61,32 @@ namespace water
             config.logging.file             = logger.attribute ("Output").as_string();
             config.logging.timestamp        = logger.attribute ("Timestamp").as_bool();
 
+            // Job settings. Older configuration files won't contain these so keep the defaults if they're missing.
+            config.jobs.threads             = jobs.attribute ("Threads").as_uint (config.jobs.threads);
+
+            // Physics settings. Older configuration files won't contain these so keep the defaults if they're missing.
+            config.physics.margin           = physics.attribute ("Margin").as_float (config.physics.margin);
+
+            // Profiler settings. Older configuration files won't contain these so keep the defaults if they're missing.
+            config.profiling.enabled        = profiler.attribute ("Enabled").as_bool (config.profiling.enabled);
+            config.profiling.capacity       = profiler.attribute ("Capacity").as_uint (config.profiling.capacity);
+            config.profiling.frames         = profiler.attribute ("Frames").as_uint (config.profiling.frames);
+            config.profiling.hitch          = profiler.attribute ("HitchMS").as_float (config.profiling.hitch);
+            config.profiling.file           = profiler.attribute ("Output").as_string (config.profiling.file.c_str());
+
             // Renderer settings.
             config.rendering.screenWidth    = renderer.attribute ("ScreenWidth").as_int();
             config.rendering.screenHeight   = renderer.attribute ("ScreenHeight").as_int();
             config.rendering.internalWidth  = renderer.attribute ("InternalWidth").as_int();
             config.rendering.internalHeight = renderer.attribute ("InternalHeight").as_int();
             config.rendering.filterMode     = renderer.attribute ("FilterMode").as_int();
+            config.rendering.pipelined      = renderer.attribute ("Pipelined").as_bool (config.rendering.pipelined);
 
             // Time settings.
             config.time.physicsFPS          = time.attribute ("PhysicsFPS").as_uint();
             config.time.updateFPS           = time.attribute ("UpdateFPS").as_uint();
             config.time.minFPS              = time.attribute ("MinFPS").as_uint();
+            config.time.framePacing         = time.attribute ("FramePacing").as_int (config.time.framePacing);
 
             // Success!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
             return config;
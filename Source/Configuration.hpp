@@ -22,11 +22,11 @@ namespace water
         /// <summary> A structure containing information on which systems should be used by the engine. </summary>
         struct Systems final
         {
-            std::string     audio           = "sfml";   //!< The audio system to use (sfml).
-            std::string     input           = "sfml";   //!< The input system to use (sfml).
+            std::string     audio           = "sfml";   //!< The audio system to use (sfml, null).
+            std::string     input           = "sfml";   //!< The input system to use (sfml, null).
             std::string     logger          = "stl";    //!< The logging system to use (hapi, stl).
-            std::string     renderer        = "sfml";   //!< The renderer to use (sfml).
-            std::string     time            = "stl";    //!< The time system to use (stl).
+            std::string     renderer        = "sfml";   //!< The renderer to use (sfml, null).
+            std::string     time            = "stl";    //!< The time system to use (stl, fixed).
         };
 
         /// <summary> Initialisation settings for audio systems. </summary>
@@ -44,6 +44,28 @@ namespace water
             bool            timestamp       { true };   //!< Whether log messages should be timestamped.
         };
 
+        /// <summary> Initialisation settings for the job system. </summary>
+        struct Jobs final
+        {
+            unsigned int    threads         { 0 };      //!< How many threads may run jobs and physics including the main thread, zero will use every hardware thread.
+        };
+
+        /// <summary> Initialisation settings for physics systems. </summary>
+        struct Physics final
+        {
+            float           margin          { 4 };      //!< How far objects may move before the broadphase tree needs restructuring.
+        };
+
+        /// <summary> Initialisation settings for the frame profiler. </summary>
+        struct Profiling final
+        {
+            bool            enabled         { false };  //!< Whether zones should be recorded from the start.
+            unsigned int    capacity        { 16384 };  //!< How many zones each thread keeps before its oldest are overwritten.
+            unsigned int    frames          { 120 };    //!< How many of the most recent frames a trace written because of a hitch contains.
+            float           hitch           { 0 };      //!< How many milliseconds a frame may take before a trace is written, zero disables this.
+            std::string     file            = "profile.json";   //!< Where traces written because of a hitch are saved.
+        };
+
         /// <summary> Initialisation settings for rendering systems. </summary>
         struct Rendering final
         {
@@ -52,6 +74,7 @@ namespace water
             int             internalWidth   { 240 };    //!< The width of the internal resolution.
             int             internalHeight  { 232 };    //!< The height of the internal resolution.
             int             filterMode      { 0 };      //!< The desired filtering mode to use during upscaling.
+            bool            pipelined       { false };  //!< Whether to draw frames on a render thread whilst simulating the next, only the null renderer supports it.
         };
 
         /// <summary> Initialisation settings for time systems. </summary>
@@ -60,6 +83,7 @@ namespace water
             unsigned int    physicsFPS      { 60 };     //!< The desired frame rate of the physics system.
             unsigned int    updateFPS       { 0 };      //!< The desired frame rate for the standard update.
             unsigned int    minFPS          { 10 };     //!< The frame rate at which the game will start slowing down instead of increasing the time step.
+            int             framePacing     { 3 };      //!< How frames wait for the next deadline (0 spin, 1 yield, 2 sleep, 3 adaptive), others are rejected.
         };
 
 
@@ -75,7 +99,10 @@ namespace water
 
         Systems     systems     { };    //!< A structure containing information on which systems should be used by the engine.
         Audio       audio       { };    //!< Initialisation settings for audio systems.
+        Jobs        jobs        { };    //!< Initialisation settings for the job system.
         Logging     logging     { };    //!< Initialisation settings for logging systems.
+        Physics     physics     { };    //!< Initialisation settings for physics systems.
+        Profiling   profiling   { };    //!< Initialisation settings for the frame profiler.
         Rendering   rendering   { };    //!< Initialisation settings for rendering systems.
         Time        time        { };    //!< Initialisation settings for time systems.
     };
@@ -9,12 +9,19 @@
 // Engine headers.
 #include <Systems.hpp>
 
+#include <Systems/Audio/AudioNull.hpp>
 #include <Systems/Audio/AudioSFML.hpp>
 #include <Systems/GameWorld/GameWorld.hpp>
+#include <Systems/Input/InputNull.hpp>
 #include <Systems/Input/InputSFML.hpp>
 #include <Systems/Logging/LoggerSTL.hpp>
 #include <Systems/Physics/Physics.hpp>
+#include <Systems/Rendering/RendererNull.hpp>
+#include <Systems/Rendering/RenderPipeline.hpp>
+#include <Systems/Time/TimeFixed.hpp>
 #include <Systems/Time/TimeSTL.hpp>
+#include <Utility/JobSystem.hpp>
+#include <Utility/Profiler.hpp>
 
 #include <Configuration.hpp>
 
@@ -22,19 +29,6 @@
 // Engine namespace.
 namespace water
 {
-    //////////////////////////////
-    /// Systems initial values ///
-    //////////////////////////////
-
-    IAudio*     Systems::m_audio        = nullptr;
-    IGameWorld* Systems::m_gameWorld    = nullptr;
-    IInput*     Systems::m_input        = nullptr;
-    ILogger*    Systems::m_logger       = nullptr;
-    IPhysics*   Systems::m_physics      = nullptr;
-    IRenderer*  Systems::m_renderer     = nullptr;
-    ITime*      Systems::m_time         = nullptr;
-
-
     ///////////////////////////////////
     /// Constructors and destructor ///
     ///////////////////////////////////
@@ -62,8 +56,11 @@ namespace water
             m_audio             = move.m_audio;
             m_gameWorld         = move.m_gameWorld;
             m_input             = move.m_input;
+            m_jobs              = move.m_jobs;
+            m_logger            = move.m_logger;
             m_physics           = move.m_physics;
             m_renderer          = move.m_renderer;
+            m_pipeline          = move.m_pipeline;
             m_time              = move.m_time;
             m_ready             = move.m_ready;
 
@@ -71,9 +68,11 @@ namespace water
             move.m_audio        = nullptr;
             move.m_gameWorld    = nullptr;
             move.m_input        = nullptr;
+            move.m_jobs         = nullptr;
             move.m_logger       = nullptr;
             move.m_physics      = nullptr;
             move.m_renderer     = nullptr;
+            move.m_pipeline     = nullptr;
             move.m_time         = nullptr;
             move.m_ready        = false;
 
@@ -171,32 +170,83 @@ namespace water
             // Enable the requested GameWorld state.
             m_gameWorld->processQueue();
 
-            // If the renderer fails we must close.
-            while (!m_gameWorld->isStackEmpty())// && m_renderer->update())
+            // The renderer is updated after rendering, if it fails we must close.
+            while (!m_gameWorld->isStackEmpty())
             {
-                // Update systems regardless of frame time.
-                m_audio->update();
+                WATER_PROFILE_FRAME();
 
-                // Only perform a physics update if the time specifies so.
-                if (m_time->updatePhysics())
+                // Perform as many fixed physics updates as the time specifies, this may be several after a slow frame.
                 {
-                    m_gameWorld->updatePhysics();
-                    m_physics->detectCollisions (m_gameWorld->getPhysicsObjects());
+                    WATER_PROFILE_ZONE ("Physics");
+
+                    const auto steps = m_time->updatePhysics();
+
+                    if (steps > 0)
+                    {
+                        m_physics->simulate (m_gameWorld->getPhysicsObjects(), m_time->getDelta(), steps, [this] ()
+                        {
+                            m_gameWorld->updatePhysics();
+                        });
+                    }
                 }
 
                 // Only perform an update if the time specifies so.
                 if (m_time->update())
                 {
+                    WATER_PROFILE_ZONE ("Update");
+
                     m_input->update();
                     m_gameWorld->update();
                 }
 
-                // Render the beautiful imagery all over the screen!
-                m_gameWorld->render();
+                // Render the beautiful imagery all over the screen! When pipelined this only records the frame, the render thread draws
+                // it whilst we simulate the next one, so a failure is only seen a frame later. If the renderer fails we must close.
+                {
+                    WATER_PROFILE_ZONE ("Render");
+                    m_gameWorld->render();
+                }
+
+                // Presenting can't reach game code so it's the one phase which can't use the audio system, audio is updated by a job
+                // alongside it. The job refers to the counter so it must finish even if presenting throws, a failed job rethrows here.
+                {
+                    WATER_PROFILE_ZONE ("Present");
+
+                    util::JobCounter audio { };
+
+                    m_jobs->run ([this] ()
+                    {
+                        WATER_PROFILE_ZONE ("Audio");
+                        m_audio->update();
+                    }, &audio);
+
+                    auto presented = false;
+
+                    try
+                    {
+                        presented = m_pipeline ? m_pipeline->present() : !m_renderer || m_renderer->update();
+                    }
+
+                    catch (...)
+                    {
+                        m_jobs->wait (audio);
+                        throw;
+                    }
+
+                    m_jobs->wait (audio);
+
+                    if (!presented)
+                    {
+                        break;
+                    }
+                }
 
                 // End frame-sensitive systems.
                 m_gameWorld->processQueue();
-                m_time->endFrame();
+
+                {
+                    WATER_PROFILE_ZONE ("End frame");
+                    m_time->endFrame();
+                }
             }
         }
 
@@ -209,6 +259,16 @@ namespace water
         {
             m_logger->logError ("Engine::run(), an unexpected error occurred.");
         }
+
+        // Report how well frames were paced so the policy can be tuned for the machine.
+        const auto stats = m_time->getFrameStats();
+
+        if (stats.frames != 0)
+        {
+            m_logger->log ("Frame pacing: " + std::to_string (stats.frames) + " frames averaging " + std::to_string (stats.averageFrame * 1000.f) +
+                           "ms, " + std::to_string (stats.waits) + " waits with " + std::to_string (stats.averageJitter * 1000.f) + "ms average and " +
+                           std::to_string (stats.maxJitter * 1000.f) + "ms maximum jitter, " + std::to_string (stats.cpuUsage * 100.f) + "% CPU usage.");
+        }
     }
 
 
@@ -233,8 +293,10 @@ namespace water
         if (m_audio)        { delete m_audio;       m_audio = nullptr; }
         if (m_input)        { delete m_input;       m_input = nullptr; }
         if (m_physics)      { delete m_physics;     m_physics = nullptr; }
+        if (m_pipeline)     { delete m_pipeline;    m_pipeline = nullptr; }
         if (m_renderer)     { delete m_renderer;    m_renderer = nullptr; }
         if (m_time)         { delete m_time;        m_time = nullptr; }
+        if (m_jobs)         { delete m_jobs;        m_jobs = nullptr; }
         if (m_logger)       { delete m_logger;      m_logger = nullptr; }
     }
 
@@ -255,6 +317,11 @@ namespace water
             m_audio = new AudioSFML();
         }
 
+        else if (config.systems.audio == "null")
+        {
+            m_audio = new AudioNull();
+        }
+
         else { return false; }
 
         // Input!
@@ -263,24 +330,50 @@ namespace water
             m_input = new InputSFML();
         }
 
+        else if (config.systems.input == "null")
+        {
+            m_input = new InputNull();
+        }
+
+        else { return false; }
+
         // Graphics!
         if (config.systems.renderer == "sfml" || config.systems.renderer == "")
         {
             //m_renderer = new RendererHAPI();
         }
 
+        else if (config.systems.renderer == "null")
+        {
+            m_renderer = new RendererNull();
+        }
+
         else { return false; }
 
-        // Time!
+        // Time! Fixed time runs one physics update per frame as fast as possible, ideal for headless simulation.
         if (config.systems.time == "stl" || config.systems.time == "")
         {
             m_time = new TimeSTL();
         }
 
+        else if (config.systems.time == "fixed")
+        {
+            m_time = new TimeFixed();
+        }
+
         else { return false; }
 
+        // The pacing policy is given as a number, anything outside of FramePacing is as invalid as an unknown system name.
+        if (config.time.framePacing < (int) FramePacing::Spin || config.time.framePacing > (int) FramePacing::Adaptive)
+        {
+            return false;
+        }
+
         m_physics = new Physics();
 
+        // The job system isn't configurable by name, every engine has one.
+        m_jobs = new util::JobSystem (config.jobs.threads);
+
         // We made it!
         return true;
     }
@@ -305,13 +398,37 @@ namespace water
 
         m_input->initialise();
 
-        /*m_renderer->initialise (config.rendering.screenWidth,   config.rendering.screenHeight,
-                                config.rendering.internalWidth, config.rendering.internalHeight,
-                                (FilterMode) config.rendering.filterMode);*/
+        // The SFML renderer doesn't exist yet so there may not be a renderer to initialise.
+        if (m_renderer)
+        {
+            m_renderer->initialise (config.rendering.screenWidth,   config.rendering.screenHeight,
+                                    config.rendering.internalWidth, config.rendering.internalHeight,
+                                    (FilterMode) config.rendering.filterMode);
+        }
+
+        // The pipeline drives the renderer from its own thread so it must only be created once the renderer is ready. Only the null
+        // renderer currently exists, so without it there's nothing to pipeline and the option is ignored.
+        if (config.rendering.pipelined && m_renderer)
+        {
+            m_pipeline = new RenderPipeline (*m_renderer);
+        }
+
+        else if (config.rendering.pipelined)
+        {
+            m_logger->logWarning ("Engine::initialiseSystems(), pipelined rendering requires a renderer which supports it, only the null renderer "
+                                  "currently does. Rendering will not be pipelined.");
+        }
 
         m_time->initialise (config.time.physicsFPS, config.time.updateFPS, config.time.minFPS);
+        m_time->setFramePacing ((FramePacing) config.time.framePacing);
 
-        m_physics->initialise();
+        m_physics->initialise (config.physics.margin, m_jobs);
+
+        // The profiler can still be enabled later, in which case it uses the default settings.
+        if (config.profiling.enabled)
+        {
+            util::Profiler::initialise (config.profiling.capacity, config.profiling.frames, config.profiling.hitch / 1000.f, config.profiling.file);
+        }
     }
 
 
@@ -320,9 +437,11 @@ namespace water
         // Set each system in the Systems class so that every game object gains access.
         Systems::setLogger (m_logger);
         Systems::setAudio (m_audio);
-        //Systems::setRenderer (m_renderer);
+        // When pipelined the game draws into the pipeline rather than the renderer.
+        Systems::setRenderer (m_pipeline ? static_cast<IRenderer*> (m_pipeline) : m_renderer);
         Systems::setTime (m_time);
         Systems::setInput (m_input);
+        Systems::setJobs (m_jobs);
         Systems::setPhysics (m_physics);
         Systems::setGameWorld (m_gameWorld);
     }
@@ -6,6 +6,10 @@
 #include <string>
 
 
+// Forward declarations.
+namespace util { class JobSystem; }
+
+
 /// <summary>
 /// The namespace of every aspect of the water engine. This includes renderering systems, audio systems, logging systems,
 /// input systems, etc. Everything that is required to make a simple 2D game.
@@ -22,12 +26,25 @@ namespace water
     class IEngineRenderer;
     class IEngineTime;
     class IGameWorld;
+    class RenderPipeline;
 
 
     /// <summary>
     /// The Engine class is the entry point for game application that want to use the water engine as the basis for their game.
     /// Water provides simple interfaces which grant access to the core systems a game needs to function. The water engine uses
     /// a state system which allows states to be stacked on top of each other, allowing for easy manipulation of game flow.
+    ///
+    /// The engine owns a single job system which every system shares, so cores are never oversubscribed. Physics spreads collision
+    /// detection across it and, as presenting a frame never reaches game code, the audio system is updated by a job whilst the frame
+    /// is presented. Physics, the game update and rendering otherwise run in order on the thread which called run(), as each may use
+    /// any system and input and rendering must stay on the thread which owns the window. No system is ever used by two threads at once.
+    ///
+    /// When rendering is pipelined the frame's draw calls are recorded during render() and drawn by a dedicated render thread whilst
+    /// the next frame is simulated, so a frame is displayed one frame later than it was simulated. The renderer must then support being
+    /// driven from a thread other than the one which created its window, which currently only the null renderer does.
+    ///
+    /// Audio, input and rendering can each use a "null" system which does nothing, combined with "fixed" time the engine runs headless,
+    /// simulating one physics update per frame as fast as the hardware allows.
     /// </summary>
     class Engine final
     {
@@ -121,9 +138,11 @@ namespace water
             IEngineAudio*       m_audio     { nullptr };    //!< The audio system used for playing audio.
             IEngineGameWorld*   m_gameWorld { nullptr };    //!< A state manager used to control the flow of the game.
             IEngineInput*       m_input     { nullptr };    //!< An input system, the main port of call for user interaction.
+            util::JobSystem*    m_jobs      { nullptr };    //!< The job system which runs independent work across every core.
             IEngineLogger*      m_logger    { nullptr };    //!< The logging system used for logging messages throughout the engine and game.
             IEnginePhysics*     m_physics   { nullptr };    //!< The physics system used by the engine.
             IEngineRenderer*    m_renderer  { nullptr };    //!< The renderering system used for drawing onto the screen.
+            RenderPipeline*     m_pipeline  { nullptr };    //!< Records draw calls for the render thread when rendering is pipelined.
             IEngineTime*        m_time      { nullptr };    //!< The time system used for maintaining the game loop and delta time.
 
             bool                m_ready     { false };      //!< A flag to indicate whether the engine is ready to run or not.
@@ -25,10 +25,14 @@ namespace water
             m_box = std::move (move.m_box);
             m_layer = move.m_layer;
             m_isTrigger = move.m_isTrigger;
+            m_shape = move.m_shape;
+            m_radius = move.m_radius;
 
             // Reset primitives
             move.m_layer = false;
             move.m_isTrigger = false;
+            move.m_shape = ColliderShape::Box;
+            move.m_radius = 0.f;
         }
 
         return *this;
@@ -44,6 +48,19 @@ namespace water
         if (box.isValid())
         {
             m_box = box;
+            m_shape = ColliderShape::Box;
+            m_radius = 0.f;
+        }
+    }
+
+
+    void Collider::setCircle (const Vector2<float>& centre, const float radius)
+    {
+        if (radius > 0.f)
+        {
+            m_box = { centre.x - radius, centre.y - radius, centre.x + radius, centre.y + radius };
+            m_shape = ColliderShape::Circle;
+            m_radius = radius;
         }
     }
 
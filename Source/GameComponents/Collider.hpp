@@ -4,14 +4,24 @@
 
 // Engine headers.
 #include <Misc/Rectangle.hpp>
+#include <Misc/Vector2.hpp>
 
 
 // Engine namespace.
 namespace water
 {
+    /// <summary> The shapes which a collider can take. </summary>
+    enum class ColliderShape : int
+    {
+        Box     = 0,    //!< The collider is its box.
+        Circle  = 1     //!< The collider is a circle which fits exactly inside its box.
+    };
+
+
     /// <summary>
     /// A basic structure containing 2D physics information. The collider class enforces correct positioning of
-    /// the rectangular collision box.
+    /// the rectangular collision box. Circular colliders keep their bounding box as the box so the broadphase can treat every
+    /// collider the same, only the narrowphase and queries consider the circle itself.
     /// </summary>
     class Collider final
     {
@@ -34,19 +44,33 @@ namespace water
             /// Getters and setters ///
             ///////////////////////////
 
-            /// <summary> Obtain a reference to the box of the collider. </summary>
+            /// <summary> Obtain a reference to the box of the collider, for circles this is the box the circle fits inside. </summary>
             const Rectangle<float>& getBox() const  { return m_box; }
 
+            /// <summary> Obtains the shape of the collider. </summary>
+            ColliderShape getShape() const          { return m_shape; }
+
+            /// <summary> Obtains the radius of a circular collider, zero if the collider is a box. </summary>
+            float getRadius() const                 { return m_radius; }
+
             /// <summary> Obtains the layer ID of the collider. </summary>
             unsigned int getLayer() const           { return m_layer; }
 
             /// <summary> Indicates whether the collider is a trigger collider. </summary>
             bool isTrigger() const                  { return m_isTrigger; }
 
-            /// <summary> Sets the bounding box of the collider, this should be the size and offset of the collider. </summary>
+            /// <summary> Sets the bounding box of the collider, this should be the size and offset of the collider. Circles become boxes. </summary>
             /// <param name="box"> The desired collision box, this will be checked for validity and ignored if invalid. </param>
             void setBox (const Rectangle<float>& box);
 
+            /// <summary>
+            /// Turns the collider into a circle. Circles are tested exactly against boxes and other circles but continuous colliders
+            /// are swept, and penetrations resolved, using the box the circle fits inside.
+            /// </summary>
+            /// <param name="centre"> The offset of the centre of the circle. </param>
+            /// <param name="radius"> The radius of the circle, this will be ignored unless it's positive. </param>
+            void setCircle (const Vector2<float>& centre, const float radius);
+
             /// <summary> Sets the layer of the collider, this determines which objects it should collide with. </summary>
             /// <param name="layer"> This value must range from 0 to 31 to be valid. </param>
             void setLayer (const unsigned int layer);
@@ -64,6 +88,8 @@ namespace water
             Rectangle<float>    m_box       { 0, 0, 1, 1 }; //!< The collider offset and size.
             unsigned int        m_layer     { 0 };          //!< The layer of the collider, is a 0 to 32 value which effects which objects collide with it.
             bool                m_isTrigger { false };      //!< Determines whether other objects can enter the collision area and how the collider is handled.
+            ColliderShape       m_shape     { };            //!< The shape of the collider.
+            float               m_radius    { 0.f };        //!< The radius of a circular collider, zero for boxes.
     };
 }
 
@@ -0,0 +1,66 @@
+#if !defined WATER_ENTITY_COMPONENTS_INCLUDED
+#define WATER_ENTITY_COMPONENTS_INCLUDED
+
+
+// Engine headers.
+#include <Interfaces/IRenderer.hpp>
+#include <Misc/Rectangle.hpp>
+#include <Misc/Vector2.hpp>
+
+
+// Engine namespace.
+namespace water
+{
+    /// <summary>
+    /// The flags of each component an entity can have. An entity's components are a combination of these flags and every entity
+    /// with the same combination is stored together.
+    /// </summary>
+    struct Components final
+    {
+        enum : unsigned int
+        {
+            None        = 0,        //!< The entity has no components, it only has a handle.
+            Transform   = 1 << 0,   //!< The entity has a position in the world.
+            Velocity    = 1 << 1,   //!< The entity moves by its velocity every physics update.
+            Collider    = 1 << 2,   //!< The entity is checked against the objects of the physics system every physics update.
+            Sprite      = 1 << 3,   //!< The entity is drawn every frame.
+            All         = 15        //!< Every component.
+        };
+    };
+
+
+    /// <summary> The position of an entity in the world. </summary>
+    struct Transform final
+    {
+        Vector2<float>  position    { 0, 0 };   //!< The top-left of the entity in world units.
+    };
+
+
+    /// <summary> How far an entity moves each second, only applied to entities with a Transform. </summary>
+    struct Velocity final
+    {
+        Vector2<float>  velocity    { 0, 0 };   //!< The velocity in world units per second.
+    };
+
+
+    /// <summary>
+    /// A box checked against the colliders of every PhysicsObject on a colliding layer, only applied to entities with a Transform.
+    /// Entities are never checked against each other.
+    /// </summary>
+    struct EntityCollider final
+    {
+        Rectangle<float>    box     { };        //!< The box relative to the position of the entity.
+        unsigned int        layer   { 0 };      //!< The layer of the collider, must be lower than 32.
+    };
+
+
+    /// <summary> The texture an entity is drawn with, only applied to entities with a Transform. </summary>
+    struct Sprite final
+    {
+        TextureID   texture { 0 };              //!< The texture to draw.
+        Point       frame   { 0, 0 };           //!< The frame of the texture to draw, 0, 0 means either the first frame or the entire texture.
+        BlendType   blend   { };                //!< The blending to be used when drawing.
+    };
+}
+
+#endif
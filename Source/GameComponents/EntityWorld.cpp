@@ -0,0 +1,300 @@
+#include "EntityWorld.hpp"
+
+
+// Engine headers.
+#include <Interfaces/IRenderer.hpp>
+
+
+// Engine namespace.
+namespace water
+{
+    ///////////////////
+    /// EntityChunk ///
+    ///////////////////
+
+    EntityChunk::EntityChunk (const unsigned int components)
+        : m_components (components)
+    {
+        const auto capacity = getCapacity();
+
+        m_entities.reserve (capacity);
+
+        if ((components & Components::Transform) != 0)  { m_transforms.reserve (capacity); }
+        if ((components & Components::Velocity) != 0)   { m_velocities.reserve (capacity); }
+        if ((components & Components::Collider) != 0)   { m_colliders.reserve (capacity); }
+        if ((components & Components::Sprite) != 0)     { m_sprites.reserve (capacity); }
+    }
+
+
+    unsigned int EntityChunk::add (const util::SlotHandle entity)
+    {
+        m_entities.push_back (entity);
+
+        if ((m_components & Components::Transform) != 0)    { m_transforms.emplace_back(); }
+        if ((m_components & Components::Velocity) != 0)     { m_velocities.emplace_back(); }
+        if ((m_components & Components::Collider) != 0)     { m_colliders.emplace_back(); }
+        if ((m_components & Components::Sprite) != 0)       { m_sprites.emplace_back(); }
+
+        return size() - 1;
+    }
+
+
+    void EntityChunk::fill (const unsigned int row, EntityChunk& last)
+    {
+        // Both chunks belong to the same archetype so every array is either used by both or by neither.
+        m_entities[row] = last.m_entities.back();
+        last.m_entities.pop_back();
+
+        if ((m_components & Components::Transform) != 0)    { m_transforms[row] = last.m_transforms.back(); last.m_transforms.pop_back(); }
+        if ((m_components & Components::Velocity) != 0)     { m_velocities[row] = last.m_velocities.back(); last.m_velocities.pop_back(); }
+        if ((m_components & Components::Collider) != 0)     { m_colliders[row] = last.m_colliders.back(); last.m_colliders.pop_back(); }
+        if ((m_components & Components::Sprite) != 0)       { m_sprites[row] = last.m_sprites.back(); last.m_sprites.pop_back(); }
+    }
+
+
+    void EntityChunk::copy (const unsigned int row, const EntityChunk& source, const unsigned int sourceRow)
+    {
+        const auto shared = m_components & source.m_components;
+
+        if ((shared & Components::Transform) != 0)  { m_transforms[row] = source.m_transforms[sourceRow]; }
+        if ((shared & Components::Velocity) != 0)   { m_velocities[row] = source.m_velocities[sourceRow]; }
+        if ((shared & Components::Collider) != 0)   { m_colliders[row] = source.m_colliders[sourceRow]; }
+        if ((shared & Components::Sprite) != 0)     { m_sprites[row] = source.m_sprites[sourceRow]; }
+    }
+
+
+    ///////////////////////////////////
+    /// Constructors and destructor ///
+    ///////////////////////////////////
+
+    EntityWorld::EntityWorld()
+    {
+        // Every combination of components has its own archetype, indexed by the combination itself.
+        m_archetypes.resize (Components::All + 1);
+    }
+
+
+    EntityWorld::EntityWorld (EntityWorld&& move)
+    {
+        *this = std::move (move);
+    }
+
+
+    EntityWorld& EntityWorld::operator= (EntityWorld&& move)
+    {
+        if (this != &move)
+        {
+            m_archetypes    = std::move (move.m_archetypes);
+            m_locations     = std::move (move.m_locations);
+            m_contacts      = std::move (move.m_contacts);
+            m_regions       = std::move (move.m_regions);
+            m_layers        = std::move (move.m_layers);
+            m_overlaps      = std::move (move.m_overlaps);
+
+            // The moved world must remain usable.
+            move.m_archetypes.resize (Components::All + 1);
+        }
+
+        return *this;
+    }
+
+
+    /////////////////////////
+    /// Entity management ///
+    /////////////////////////
+
+    util::SlotHandle EntityWorld::create (const unsigned int components)
+    {
+        // The location is fixed up once the handle is known, the chunk needs the handle to find the entity when rows are moved.
+        const auto entity = m_locations.insert ({ });
+
+        *m_locations.find (entity) = add (entity, components & Components::All);
+
+        return entity;
+    }
+
+
+    bool EntityWorld::destroy (const util::SlotHandle entity)
+    {
+        const auto location = m_locations.find (entity);
+
+        if (!location)
+        {
+            return false;
+        }
+
+        remove (*location);
+        m_locations.erase (entity);
+
+        return true;
+    }
+
+
+    void EntityWorld::clear()
+    {
+        for (auto& archetype : m_archetypes)
+        {
+            archetype.clear();
+        }
+
+        m_locations.clear();
+        m_contacts.clear();
+    }
+
+
+    bool EntityWorld::setComponents (const util::SlotHandle entity, const unsigned int components)
+    {
+        const auto location = m_locations.find (entity);
+
+        if (!location)
+        {
+            return false;
+        }
+
+        // Nothing needs to move if the archetype stays the same.
+        const auto previous = *location;
+        const auto target   = components & Components::All;
+
+        if (previous.components != target)
+        {
+            // Adding may create a chunk and invalidate references to the chunks of the target archetype, but never the source archetype.
+            const auto  next    = add (entity, target);
+            const auto& source  = m_archetypes[previous.components][previous.chunk];
+
+            m_archetypes[target][next.chunk].copy (next.row, source, previous.row);
+
+            remove (previous);
+            *m_locations.find (entity) = next;
+        }
+
+        return true;
+    }
+
+
+    ///////////////
+    /// Getters ///
+    ///////////////
+
+    unsigned int EntityWorld::getComponents (const util::SlotHandle entity) const
+    {
+        const auto location = m_locations.find (entity);
+
+        return location ? location->components : (unsigned int) Components::None;
+    }
+
+
+    ///////////////
+    /// Systems ///
+    ///////////////
+
+    void EntityWorld::integrate (const float delta)
+    {
+        forEach (Components::Transform | Components::Velocity, [=] (EntityChunk& chunk)
+        {
+            const auto  count       = chunk.size();
+            auto        transforms  = chunk.getTransforms();
+            const auto  velocities  = chunk.getVelocities();
+
+            for (auto i = 0U; i < count; ++i)
+            {
+                transforms[i].position.x += velocities[i].velocity.x * delta;
+                transforms[i].position.y += velocities[i].velocity.y * delta;
+            }
+        });
+    }
+
+
+    void EntityWorld::findContacts (const IPhysics& physics)
+    {
+        m_contacts.clear();
+
+        forEach (Components::Transform | Components::Collider, [&] (const EntityChunk& chunk)
+        {
+            // Gather the world-space box of every entity in the chunk so the physics system can query them in one call.
+            const auto count        = chunk.size();
+            const auto transforms   = chunk.getTransforms();
+            const auto colliders    = chunk.getColliders();
+            const auto entities     = chunk.getEntities();
+
+            m_regions.resize (count);
+            m_layers.resize (count);
+
+            for (auto i = 0U; i < count; ++i)
+            {
+                const auto& position    = transforms[i].position;
+                const auto& box         = colliders[i].box;
+
+                m_regions[i]    = { box.getLeft() + position.x, box.getTop() + position.y, box.getRight() + position.x, box.getBottom() + position.y };
+                m_layers[i]     = colliders[i].layer;
+            }
+
+            physics.queryRegions (m_regions.data(), m_layers.data(), count, m_overlaps);
+
+            for (const auto& overlap : m_overlaps)
+            {
+                m_contacts.push_back ({ entities[overlap.region], overlap.object });
+            }
+        });
+    }
+
+
+    void EntityWorld::render (IRenderer& renderer) const
+    {
+        forEach (Components::Transform | Components::Sprite, [&] (const EntityChunk& chunk)
+        {
+            const auto count        = chunk.size();
+            const auto transforms   = chunk.getTransforms();
+            const auto sprites      = chunk.getSprites();
+
+            for (auto i = 0U; i < count; ++i)
+            {
+                const auto& sprite = sprites[i];
+                renderer.drawToScreen (transforms[i].position, sprite.texture, sprite.frame, sprite.blend);
+            }
+        });
+    }
+
+
+    /////////////////////////
+    /// Internal workings ///
+    /////////////////////////
+
+    EntityWorld::Location EntityWorld::add (const util::SlotHandle entity, const unsigned int components)
+    {
+        auto& chunks = m_archetypes[components];
+
+        if (chunks.empty() || chunks.back().size() == EntityChunk::getCapacity())
+        {
+            chunks.push_back (EntityChunk (components));
+        }
+
+        const auto chunk    = (unsigned int) chunks.size() - 1;
+        const auto row      = chunks.back().add (entity);
+
+        return { components, chunk, row };
+    }
+
+
+    void EntityWorld::remove (const Location& location)
+    {
+        // Keep the archetype packed by moving its very last entity into the gap.
+        auto& chunks    = m_archetypes[location.components];
+        auto& last      = chunks.back();
+        auto& chunk     = chunks[location.chunk];
+
+        const auto  removed = chunk.m_entities[location.row];
+        const auto  moved   = last.m_entities.back();
+
+        chunk.fill (location.row, last);
+
+        if (moved != removed)
+        {
+            *m_locations.find (moved) = location;
+        }
+
+        if (last.size() == 0)
+        {
+            chunks.pop_back();
+        }
+    }
+}
@@ -0,0 +1,343 @@
+#if !defined WATER_ENTITY_WORLD_INCLUDED
+#define WATER_ENTITY_WORLD_INCLUDED
+
+
+// STL headers.
+#include <utility>
+#include <vector>
+
+
+// Engine headers.
+#include <GameComponents/EntityComponents.hpp>
+#include <Interfaces/IPhysics.hpp>
+#include <Utility/SlotMap.hpp>
+
+
+// Engine namespace.
+namespace water
+{
+    // Forward declarations.
+    class IRenderer;
+    class PhysicsObject;
+
+
+    /// <summary> An entity whose collider touched an object during the latest physics update. </summary>
+    struct EntityContact final
+    {
+        util::SlotHandle    entity  { };            //!< The entity which touched the object.
+        PhysicsObject*      object  { nullptr };    //!< The object which was touched.
+    };
+
+
+    /// <summary>
+    /// A fixed capacity block of entities which all have the same components. Each component is kept in its own contiguous array
+    /// so systems only touch the memory they need, components the entities don't have are empty arrays. The arrays are reserved up
+    /// front and the pointers are valid until entities are created, destroyed or change components.
+    /// </summary>
+    class EntityChunk final
+    {
+        public:
+
+            /// <summary> Obtains how many entities a single chunk can hold. </summary>
+            static unsigned int getCapacity()                   { return 1024; }
+
+            /// <summary> Obtains the components of every entity in the chunk. </summary>
+            unsigned int getComponents() const                  { return m_components; }
+
+            /// <summary> Obtains how many entities are in the chunk. </summary>
+            unsigned int size() const                           { return (unsigned int) m_entities.size(); }
+
+            /// <summary> Obtains the handle of each entity in the chunk. </summary>
+            const util::SlotHandle* getEntities() const         { return m_entities.data(); }
+
+            /// <summary> Obtains the Transform of each entity, nullptr if the entities don't have one. </summary>
+            Transform* getTransforms()                          { return get (m_transforms, Components::Transform); }
+            const Transform* getTransforms() const              { return get (m_transforms, Components::Transform); }
+
+            /// <summary> Obtains the Velocity of each entity, nullptr if the entities don't have one. </summary>
+            Velocity* getVelocities()                           { return get (m_velocities, Components::Velocity); }
+            const Velocity* getVelocities() const               { return get (m_velocities, Components::Velocity); }
+
+            /// <summary> Obtains the EntityCollider of each entity, nullptr if the entities don't have one. </summary>
+            EntityCollider* getColliders()                      { return get (m_colliders, Components::Collider); }
+            const EntityCollider* getColliders() const          { return get (m_colliders, Components::Collider); }
+
+            /// <summary> Obtains the Sprite of each entity, nullptr if the entities don't have one. </summary>
+            Sprite* getSprites()                                { return get (m_sprites, Components::Sprite); }
+            const Sprite* getSprites() const                    { return get (m_sprites, Components::Sprite); }
+
+        private:
+
+            // Let EntityWorld manage the contents of the chunk.
+            friend class EntityWorld;
+
+            /// <summary> Reserves the full capacity for the entity handles and every component the chunk stores. </summary>
+            explicit EntityChunk (const unsigned int components);
+
+            /// <summary> Adds an entity with default constructed components. </summary>
+            /// <returns> The row of the entity. </returns>
+            unsigned int add (const util::SlotHandle entity);
+
+            /// <summary> Moves the components of the last entity in another chunk into a row, then removes the last entity. </summary>
+            void fill (const unsigned int row, EntityChunk& last);
+
+            /// <summary> Copies the components two chunks have in common from one entity to another. </summary>
+            void copy (const unsigned int row, const EntityChunk& source, const unsigned int sourceRow);
+
+            template <typename T> T* get (std::vector<T>& components, const unsigned int flag)
+            {
+                return (m_components & flag) != 0 ? components.data() : nullptr;
+            }
+
+            template <typename T> const T* get (const std::vector<T>& components, const unsigned int flag) const
+            {
+                return (m_components & flag) != 0 ? components.data() : nullptr;
+            }
+
+            unsigned int                    m_components    { 0 };  //!< The components which every entity in the chunk has.
+            std::vector<util::SlotHandle>   m_entities      { };    //!< The handle of the entity in each row.
+            std::vector<Transform>          m_transforms    { };    //!< The Transform of each entity, if they have one.
+            std::vector<Velocity>           m_velocities    { };    //!< The Velocity of each entity, if they have one.
+            std::vector<EntityCollider>     m_colliders     { };    //!< The EntityCollider of each entity, if they have one.
+            std::vector<Sprite>             m_sprites       { };    //!< The Sprite of each entity, if they have one.
+    };
+
+
+    /// <summary>
+    /// A data-oriented alternative to GameObject and PhysicsObject for large numbers of simple entities such as debris, crowds or
+    /// pickups. Entities are handles to a combination of plain components, every entity with the same combination is stored in the
+    /// same archetype as a list of chunks. Systems iterate the component arrays of each chunk rather than calling virtual functions
+    /// on objects scattered around the heap. Destroying an entity moves the last entity of its archetype into the gap, so every
+    /// chunk but the last of each archetype is always full.
+    ///
+    /// Each GameState owns an EntityWorld. The GameWorld moves entities by their velocity and finds their contacts after the state
+    /// performs each physics update, then draws them after the state renders. Worlds can be moved but not copied because a copied
+    /// chunk wouldn't keep the capacity reserved for it.
+    /// </summary>
+    class EntityWorld final
+    {
+        public:
+
+            ///////////////////////////////////
+            /// Constructors and destructor ///
+            ///////////////////////////////////
+
+            EntityWorld();
+            EntityWorld (const EntityWorld& copy)               = delete;
+            EntityWorld& operator= (const EntityWorld& copy)    = delete;
+            ~EntityWorld()                                      = default;
+
+            EntityWorld (EntityWorld&& move);
+            EntityWorld& operator= (EntityWorld&& move);
+
+
+            /////////////////////////
+            /// Entity management ///
+            /////////////////////////
+
+            /// <summary> Creates an entity with default constructed components. </summary>
+            /// <param name="components"> The components of the entity, a combination of the Components flags. </param>
+            /// <returns> The handle of the entity. </returns>
+            util::SlotHandle create (const unsigned int components);
+
+            /// <summary> Destroys an entity, the handle and any copies of it will become stale. </summary>
+            /// <returns> Whether the handle referred to an entity. </returns>
+            bool destroy (const util::SlotHandle entity);
+
+            /// <summary> Destroys every entity, every handle will become stale. </summary>
+            void clear();
+
+            /// <summary>
+            /// Changes the components of an entity, moving it to a different archetype. Components the entity keeps maintain their value,
+            /// components which are added are default constructed.
+            /// </summary>
+            /// <param name="entity"> The entity to modify. </param>
+            /// <param name="components"> The new components of the entity, a combination of the Components flags. </param>
+            /// <returns> Whether the handle referred to an entity. </returns>
+            bool setComponents (const util::SlotHandle entity, const unsigned int components);
+
+
+            ///////////////
+            /// Getters ///
+            ///////////////
+
+            /// <summary> Obtains the number of entities. </summary>
+            unsigned int size() const                               { return m_locations.size(); }
+
+            /// <summary> Indicates whether there are no entities. </summary>
+            bool isEmpty() const                                    { return m_locations.isEmpty(); }
+
+            /// <summary> Checks whether a handle refers to an entity which hasn't been destroyed. </summary>
+            bool contains (const util::SlotHandle entity) const     { return m_locations.contains (entity); }
+
+            /// <summary> Obtains the components of an entity, Components::None if the handle is stale. </summary>
+            unsigned int getComponents (const util::SlotHandle entity) const;
+
+            /// <summary> Finds the Transform of an entity. </summary>
+            /// <returns> The component, nullptr if the handle is stale or the entity doesn't have one. </returns>
+            Transform* getTransform (const util::SlotHandle entity)                 { return find (entity, &EntityChunk::m_transforms, Components::Transform); }
+            const Transform* getTransform (const util::SlotHandle entity) const     { return find (entity, &EntityChunk::m_transforms, Components::Transform); }
+
+            /// <summary> Finds the Velocity of an entity. </summary>
+            /// <returns> The component, nullptr if the handle is stale or the entity doesn't have one. </returns>
+            Velocity* getVelocity (const util::SlotHandle entity)                   { return find (entity, &EntityChunk::m_velocities, Components::Velocity); }
+            const Velocity* getVelocity (const util::SlotHandle entity) const       { return find (entity, &EntityChunk::m_velocities, Components::Velocity); }
+
+            /// <summary> Finds the EntityCollider of an entity. </summary>
+            /// <returns> The component, nullptr if the handle is stale or the entity doesn't have one. </returns>
+            EntityCollider* getCollider (const util::SlotHandle entity)             { return find (entity, &EntityChunk::m_colliders, Components::Collider); }
+            const EntityCollider* getCollider (const util::SlotHandle entity) const { return find (entity, &EntityChunk::m_colliders, Components::Collider); }
+
+            /// <summary> Finds the Sprite of an entity. </summary>
+            /// <returns> The component, nullptr if the handle is stale or the entity doesn't have one. </returns>
+            Sprite* getSprite (const util::SlotHandle entity)                       { return find (entity, &EntityChunk::m_sprites, Components::Sprite); }
+            const Sprite* getSprite (const util::SlotHandle entity) const           { return find (entity, &EntityChunk::m_sprites, Components::Sprite); }
+
+            /// <summary> Obtains the contacts found by the latest call to findContacts(), ordered by archetype and then by chunk. </summary>
+            const std::vector<EntityContact>& getContacts() const   { return m_contacts; }
+
+
+            /////////////////
+            /// Iteration ///
+            /////////////////
+
+            /// <summary>
+            /// Calls a function with every chunk whose entities have at least the given components. The function must not create,
+            /// destroy or change the components of entities.
+            /// </summary>
+            /// <param name="components"> The components which each chunk must have. </param>
+            /// <param name="function"> A function taking EntityChunk&. </param>
+            template <typename Function>
+            void forEach (const unsigned int components, Function&& function);
+
+            /// <summary> Calls a function with every chunk whose entities have at least the given components. </summary>
+            /// <param name="components"> The components which each chunk must have. </param>
+            /// <param name="function"> A function taking const EntityChunk&. </param>
+            template <typename Function>
+            void forEach (const unsigned int components, Function&& function) const;
+
+
+            ///////////////
+            /// Systems ///
+            ///////////////
+
+            /// <summary> Moves every entity with a Transform and a Velocity by its velocity. </summary>
+            /// <param name="delta"> The length of the update in seconds. </param>
+            void integrate (const float delta);
+
+            /// <summary>
+            /// Checks every entity with a Transform and an EntityCollider against the objects of a physics system, replacing the contacts.
+            /// The physics system is given the boxes of a whole chunk at once.
+            /// </summary>
+            /// <param name="physics"> The physics system to query, this reflects its most recent update. </param>
+            void findContacts (const IPhysics& physics);
+
+            /// <summary> Draws every entity with a Transform and a Sprite, in the order they're stored. </summary>
+            /// <param name="renderer"> The renderer to draw with. </param>
+            void render (IRenderer& renderer) const;
+
+        private:
+
+            /// <summary> Where the components of an entity are stored. </summary>
+            struct Location final
+            {
+                unsigned int    components  { 0 };  //!< The archetype of the entity.
+                unsigned int    chunk       { 0 };  //!< The chunk of the archetype which contains the entity.
+                unsigned int    row         { 0 };  //!< The row of the chunk which contains the entity.
+            };
+
+
+            /////////////////////////
+            /// Internal workings ///
+            /////////////////////////
+
+            /// <summary> Adds an entity to the last chunk of an archetype, adding a chunk if it's full. </summary>
+            /// <returns> The location of the entity. </returns>
+            Location add (const util::SlotHandle entity, const unsigned int components);
+
+            /// <summary> Removes the entity at a location, moving the last entity of the archetype into its place. </summary>
+            void remove (const Location& location);
+
+            template <typename T> T* find (const util::SlotHandle entity, std::vector<T> EntityChunk::* const components, const unsigned int flag);
+            template <typename T> const T* find (const util::SlotHandle entity, std::vector<T> EntityChunk::* const components, const unsigned int flag) const;
+
+
+            ///////////////////////////
+            /// Implementation data ///
+            ///////////////////////////
+
+            std::vector<std::vector<EntityChunk>>   m_archetypes    { };    //!< The chunks of each archetype, indexed by components.
+            util::SlotMap<Location>                 m_locations     { };    //!< The location of every entity.
+            std::vector<EntityContact>              m_contacts      { };    //!< The contacts found by the latest call to findContacts().
+            std::vector<Rectangle<float>>           m_regions       { };    //!< The world-space box of each entity in the chunk being checked.
+            std::vector<unsigned int>               m_layers        { };    //!< The layer of each entity in the chunk being checked.
+            std::vector<RegionOverlap>              m_overlaps      { };    //!< The overlaps found for the chunk being checked.
+    };
+
+
+    /////////////////
+    /// Iteration ///
+    /////////////////
+
+    template <typename Function> void EntityWorld::forEach (const unsigned int components, Function&& function)
+    {
+        for (auto archetype = 0U; archetype < m_archetypes.size(); ++archetype)
+        {
+            if ((archetype & components) == components)
+            {
+                for (auto& chunk : m_archetypes[archetype])
+                {
+                    function (chunk);
+                }
+            }
+        }
+    }
+
+
+    template <typename Function> void EntityWorld::forEach (const unsigned int components, Function&& function) const
+    {
+        for (auto archetype = 0U; archetype < m_archetypes.size(); ++archetype)
+        {
+            if ((archetype & components) == components)
+            {
+                for (const auto& chunk : m_archetypes[archetype])
+                {
+                    function (chunk);
+                }
+            }
+        }
+    }
+
+
+    /////////////////////////
+    /// Internal workings ///
+    /////////////////////////
+
+    template <typename T> T* EntityWorld::find (const util::SlotHandle entity, std::vector<T> EntityChunk::* const components, const unsigned int flag)
+    {
+        const auto location = m_locations.find (entity);
+
+        if (location && (location->components & flag) != 0)
+        {
+            return &(m_archetypes[location->components][location->chunk].*components)[location->row];
+        }
+
+        return nullptr;
+    }
+
+
+    template <typename T> const T* EntityWorld::find (const util::SlotHandle entity, std::vector<T> EntityChunk::* const components,
+                                                      const unsigned int flag) const
+    {
+        const auto location = m_locations.find (entity);
+
+        if (location && (location->components & flag) != 0)
+        {
+            return &(m_archetypes[location->components][location->chunk].*components)[location->row];
+        }
+
+        return nullptr;
+    }
+}
+
+#endif
@@ -22,6 +22,9 @@ namespace water
     {
         if (this != &move)
         {
+            // Our own transform is released, the transform of the moved object becomes ours.
+            detach();
+
             m_position      = std::move (move.m_position);
             m_velocity      = std::move (move.m_velocity);
             m_frame         = std::move (move.m_frame);
@@ -29,10 +32,42 @@ namespace water
             m_blendType     = move.m_blendType;
             m_name          = std::move (move.m_name);
             m_tag           = std::move (move.m_tag);
+            m_store         = move.m_store;
+            m_transform     = move.m_transform;
 
             // Reset primitives.
             move.m_baseTexture = 0;
             move.m_blendType = BlendType::Opaque;
+            move.m_store = nullptr;
+            move.m_transform = 0;
+        }
+
+        return *this;
+    }
+
+
+    GameObject::GameObject (const GameObject& copy)
+    {
+        *this = copy;
+    }
+
+
+    GameObject& GameObject::operator= (const GameObject& copy)
+    {
+        if (this != &copy)
+        {
+            // Two objects can't share a transform so the copy is detached, but it keeps any store we were already attached to.
+            const auto position = copy.getPosition();
+            const auto velocity = copy.getVelocity();
+
+            m_frame         = copy.m_frame;
+            m_baseTexture   = copy.m_baseTexture;
+            m_blendType     = copy.m_blendType;
+            m_name          = copy.m_name;
+            m_tag           = copy.m_tag;
+
+            setPosition (position);
+            setVelocity (velocity);
         }
 
         return *this;
@@ -69,6 +104,37 @@ namespace water
     }
 
 
+    /////////////////////////
+    /// Transform storage ///
+    /////////////////////////
+
+    void GameObject::attach (TransformStore& store)
+    {
+        if (m_store != &store)
+        {
+            // Take our transform out of the previous store before moving it into the new one.
+            detach();
+
+            m_transform = store.add (m_position, m_velocity);
+            m_store     = &store;
+        }
+    }
+
+
+    void GameObject::detach()
+    {
+        if (m_store)
+        {
+            m_position  = m_store->getPosition (m_transform);
+            m_velocity  = m_store->getVelocity (m_transform);
+
+            m_store->remove (m_transform);
+            m_store     = nullptr;
+            m_transform = 0;
+        }
+    }
+
+
     ///////////////
     /// Setters ///
     ///////////////
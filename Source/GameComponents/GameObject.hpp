@@ -7,6 +7,7 @@
 
 
 // Engine headers.
+#include <GameComponents/TransformStore.hpp>
 #include <Interfaces/IGameObject.hpp>
 #include <Interfaces/IRenderer.hpp>
 #include <Misc/Vector2.hpp>
@@ -24,7 +25,12 @@ namespace water
 
 
     /// <summary>
-    /// A basic abstract game object class with the common functionality required by all objects in the game.
+    /// A basic abstract game object class with the common functionality required by all objects in the game. Objects may be attached to the
+    /// TransformStore of a GameState, their position and velocity then live in the store and the object simply refers to them by index. The
+    /// store moves every attached object by its velocity after each physics update of the state, so simple movers need no update logic.
+    /// Attached physics objects have their velocity cleared when they're attached whilst static, made static or fall asleep, so they stay
+    /// where they are unless they're given a new velocity.
+    /// Attached objects must use the getters and setters rather than m_position and m_velocity, which are only used whilst detached.
     /// </summary>
     class GameObject : public IGameObject
     {
@@ -38,11 +44,12 @@ namespace water
             GameObject (GameObject&& move);
             GameObject& operator= (GameObject&& move);
 
-            GameObject (const GameObject& copy)             = default;
-            GameObject& operator= (const GameObject& copy)  = default;
+            /// <summary> Copies never share a transform, a constructed copy is detached and assignment keeps the store of the target. </summary>
+            GameObject (const GameObject& copy);
+            GameObject& operator= (const GameObject& copy);
 
-            // Ensure destructor is virtual.
-            virtual ~GameObject() override {}
+            // Ensure destructor is virtual. Attached objects release their transform.
+            virtual ~GameObject() override                  { detach(); }
 
 
             /////////////////////////////////
@@ -69,13 +76,13 @@ namespace water
             /// Getters and setters ///
             ///////////////////////////
 
-            /// <summary> Obtain a reference to the objects position. </summary>
+            /// <summary> Obtain a copy of the objects position, a copy is required as attached objects don't store it themselves. </summary>
             /// <returns> The position vector. </returns>
-            const Vector2<float>& getPosition() const           { return m_position; }
+            Vector2<float> getPosition() const                  { return m_store ? m_store->getPosition (m_transform) : m_position; }
 
-            /// <summary> Obtain a reference to the objects velocity. </summary>
+            /// <summary> Obtain a copy of the objects velocity, a copy is required as attached objects don't store it themselves. </summary>
             /// <returns> The velocity vector. </returns>
-            const Vector2<float>& getVelocity() const           { return m_velocity; }
+            Vector2<float> getVelocity() const                  { return m_store ? m_store->getVelocity (m_transform) : m_velocity; }
 
             /// <summary> Obtain a reference to the objects current frame co-ordinate. </summary>
             /// <returns> The frame co-ordinate currently in use. </returns>
@@ -99,11 +106,11 @@ namespace water
 
             /// <summary> Set the position of the object. </summary>
             /// <param name="position"> The new position to assign to the object. </param>
-            void setPosition (const Vector2<float>& position)   { m_position = position; }
+            void setPosition (const Vector2<float>& position)   { if (m_store) { m_store->setPosition (m_transform, position); } else { m_position = position; } }
 
             /// <summary> Set the velocity of the object. </summary>
             /// <param name="velocity"> The new velocity to assign to the object. </param>
-            void setVelocity (const Vector2<float>& velocity)   { m_velocity = velocity; }
+            void setVelocity (const Vector2<float>& velocity)   { if (m_store) { m_store->setVelocity (m_transform, velocity); } else { m_velocity = velocity; } }
 
             /// <summary> Set the frame which the GameObject should use to render. </summary>
             /// <param name="frame"> The desired frame co-ordinate to be rendered. </param>
@@ -126,19 +133,42 @@ namespace water
             /// <param name="tag"> The value to set the tag of the object to. </param>
             void setTag (const std::string& tag)                { m_tag = tag; }
 
+
+            /////////////////////////
+            /// Transform storage ///
+            /////////////////////////
+
+            /// <summary> Indicates whether the object is attached to a TransformStore. </summary>
+            bool isAttached() const                             { return m_store != nullptr; }
+
+            /// <summary>
+            /// Moves the position and velocity of the object into a TransformStore, detaching from any previous store. The store must outlive
+            /// the object or the object must be detached first, objects declared in a GameState are destroyed before its store.
+            /// </summary>
+            /// <param name="store"> The store to attach to. </param>
+            virtual void attach (TransformStore& store);
+
+            /// <summary> Moves the position and velocity of the object out of its TransformStore, if any. </summary>
+            void detach();
+
         protected:
 
             ///////////////////////////
             /// Implementation data ///
             ///////////////////////////
 
-            Vector2<float>  m_position      { 0, 0 };   //!< The position of the GameObject in the world.
-            Vector2<float>  m_velocity      { 0, 0 };   //!< The velocity of the GameObject. This is how much it moves in the world.
+            Vector2<float>  m_position      { 0, 0 };   //!< The position of the GameObject in the world, unused whilst attached.
+            Vector2<float>  m_velocity      { 0, 0 };   //!< The velocity of the GameObject. This is how much it moves in the world, unused whilst attached.
             Vector2<int>    m_frame         { 0, 0 };   //!< The desired frame co-ordinate of the texture. 0, 0 means either the first frame or the entire texture.
             TextureID       m_baseTexture   { 0 };      //!< The standard texture of the GameObject.
             BlendType       m_blendType     { };        //!< The blending type to be used by the object in rendering.
             std::string     m_name          = "";       //!< The name of the GameObject.
             std::string     m_tag           = "";       //!< The tag of the GameObject.
+
+        private:
+
+            TransformStore* m_store         { nullptr };    //!< The store holding the position and velocity of the object, if any.
+            unsigned int    m_transform     { 0 };          //!< The index of the transform of the object in the store.
     };
 }
 
@@ -2,7 +2,7 @@
 
 
 // STL headers.
-#include <algorithm>
+#include <utility>
 
 
 // Engine headers.
@@ -17,12 +17,16 @@ namespace water
     ///////////////////
 
     GameState::GameState (const unsigned int elementCount)
+        : m_transforms (new TransformStore())
     {
         m_objects.reserve (elementCount);
+        m_handles.reserve (elementCount);
+        m_transforms->reserve (elementCount);
     }
 
 
     GameState::GameState (GameState&& move)
+        : m_transforms (new TransformStore())
     {
         *this = std::move (move);
     }
@@ -32,7 +36,11 @@ namespace water
     {
         if (this != &move)
         {
-            m_objects = std::move (move.m_objects);
+            // Stores are swapped rather than moved, objects attached to either store still point to it so both must stay alive.
+            m_entities      = std::move (move.m_entities);
+            std::swap (m_transforms, move.m_transforms);
+            m_objects       = std::move (move.m_objects);
+            m_handles       = std::move (move.m_handles);
         }
 
         return *this;
@@ -78,45 +86,29 @@ namespace water
     /// Physics management ///
     //////////////////////////
 
-    void GameState::addPhysicsObject (PhysicsObject* const object)
+    util::SlotHandle GameState::addPhysicsObject (PhysicsObject* const object)
     {
         // Pre-condition: The object isn't a nullptr.
         if (!object)
         {
             Systems::logger().logWarning ("GameState::addPhysicsObject(), attempt to add a nullptr.");
+            return { };
         }
 
-        else
-        {
-            m_objects.push_back (object);
-        }
-    }
-
+        // Objects can only be managed once, adding an object again just gives the existing handle.
+        const auto result = m_handles.emplace (object, util::SlotHandle { });
 
-    void GameState::addUniquePhysicsObject (PhysicsObject* const object)
-    {
-        // Pre-condition: The object isn't a nullptr.
-        if (!object)
+        if (!result.second)
         {
-            Systems::logger().logWarning ("GameState::addUniquePhysicsObject(), attempt to add a nullptr.");
+            Systems::logger().logWarning ("GameState::addPhysicsObject(), attempt to add an object that has already been added.");
         }
 
         else
         {
-            // Attempt to find the object.
-            const auto iterator = findObject (object);
-
-            // If the iterator is at equal to the end we know it doesn't exist.
-            if (iterator == m_objects.end())
-            {
-                m_objects.push_back (object);
-            }
-
-            else
-            {
-                Systems::logger().logWarning ("GameState::addUniquePhysicsObject(), attempt to add an object that has already been added.");
-            }
+            result.first->second = m_objects.insert (object);
         }
+
+        return result.first->second;
     }
 
 
@@ -126,54 +118,52 @@ namespace water
         if (!object)
         {
             Systems::logger().logWarning ("GameState::removePhysicsObject(), attempt to remove a nullptr.");
+            return;
+        }
+
+        const auto iterator = m_handles.find (object);
+
+        if (iterator != m_handles.end())
+        {
+            m_objects.erase (iterator->second);
+            m_handles.erase (iterator);
         }
 
         else
         {
-            // Attempt to find the object.
-            auto iterator = findObject (object);
-
-            // Check if the result is valid.
-            if (iterator != m_objects.end())
-            {
-                // Swap and pop for efficiency!
-                std::swap (*iterator, m_objects.back());
-                m_objects.pop_back();
-            }
-
-            else
-            {
-                Systems::logger().logWarning ("GameState::removePhysicsObject(), attempt to remove a non-existent object.");
-            }
+            Systems::logger().logWarning ("GameState::removePhysicsObject(), attempt to remove a non-existent object.");
         }
     }
 
 
-    void GameState::removePhysicsObjects()
+    void GameState::removePhysicsObject (const util::SlotHandle handle)
     {
-        // Pop until empty to ensure we keep our reserved capacity.
-        while (!m_objects.empty())
+        const auto object = m_objects.find (handle);
+
+        // Pre-condition: The handle refers to an object.
+        if (!object)
         {
-            m_objects.pop_back();
+            Systems::logger().logWarning ("GameState::removePhysicsObject(), attempt to remove an object using a stale handle.");
+            return;
         }
-    }
 
+        m_handles.erase (*object);
+        m_objects.erase (handle);
+    }
 
-    ///////////////////////////
-    /// Physics integration ///
-    ///////////////////////////
 
-    std::vector<PhysicsObject*>::iterator GameState::findObject (const PhysicsObject* const object)
+    PhysicsObject* GameState::getPhysicsObject (const util::SlotHandle handle) const
     {
-        // Construct a function to find where the object is.
-        const auto equals = [=] (const PhysicsObject* const test)
-        {
-            return test == object;
-        };
+        const auto object = m_objects.find (handle);
+
+        return object ? *object : nullptr;
+    }
 
-        // Find the object.
-        const auto& location = std::find_if (m_objects.begin(), m_objects.end(), equals);
 
-        return location;
+    void GameState::removePhysicsObjects()
+    {
+        // Clearing keeps our reserved capacity.
+        m_objects.clear();
+        m_handles.clear();
     }
 }
@@ -3,9 +3,17 @@
 
 
 // STL headers.
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 
+// Engine headers.
+#include <GameComponents/EntityWorld.hpp>
+#include <GameComponents/TransformStore.hpp>
+#include <Utility/SlotMap.hpp>
+
+
 // Engine namespace.
 namespace water
 {
@@ -26,7 +34,13 @@ namespace water
     ///
     /// The way physics integrates with the game requires every engine-managed object with collision detection must both derive from the PhysicsObject class
     /// and must be enabled using GameState::addPhysicsObject(). Also if you ever need to delete a PhysicsObject you must call GameState::removePhysicsObject()
-    /// otherwise access violation errors will occur in the physics system.
+    /// otherwise access violation errors will occur in the physics system. Adding an object gives a handle which can be used to find or remove the object in
+    /// constant time, handles to removed objects are detected rather than referring to whatever replaced them.
+    ///
+    /// States also own an EntityWorld for large numbers of simple entities. Whilst the state is active its entities are moved and checked against the
+    /// physics system after every call to updatePhysics(), and drawn after every call to render(). GameObject's attached to the TransformStore of the
+    /// state are also moved by their velocity after every call to updatePhysics(). The store stays where it is when the state is moved so attached
+    /// objects keep working, states can't be copied as the copy couldn't own the attached objects.
     /// </summary>
     class GameState
     {
@@ -40,8 +54,8 @@ namespace water
             /// <param name="size"> How many elements are expected to be held by the state. </param>
             GameState (const unsigned int elementCount = 100);
 
-            GameState (const GameState& copy)               = default;
-            GameState& operator= (const GameState& copy)    = default;
+            GameState (const GameState& copy)               = delete;
+            GameState& operator= (const GameState& copy)    = delete;
 
             GameState (GameState&& move);
             GameState& operator= (GameState&& move);
@@ -102,22 +116,36 @@ namespace water
 
         protected:
 
+            /////////////////////////
+            /// Entity management ///
+            /////////////////////////
+
+            /// <summary> Obtains the entities of the state. </summary>
+            EntityWorld& entities()                 { return m_entities; }
+
+            /// <summary> Obtains the entities of the state. </summary>
+            const EntityWorld& entities() const     { return m_entities; }
+
+            /// <summary> Obtains the store which GameObject's of the state can be attached to. </summary>
+            TransformStore& transforms()            { return *m_transforms; }
+
+
             //////////////////////////
             /// Physics management ///
             //////////////////////////
 
             /// <summary>
             /// Adds a PhysicsObject to the list of objects which should be managed by the physics system. This means they will receive collsion detection.
-            /// Ensure you're never adding an object which already exists.
+            /// Objects which have already been added are detected and keep their existing handle.
             /// </summary>
             /// <param name="object"> The PhysicsObject to add, nullptr will be ignored. </param>
-            void addPhysicsObject (PhysicsObject* const object);
+            /// <returns> The handle of the object, this refers to nothing if the object was a nullptr. </returns>
+            util::SlotHandle addPhysicsObject (PhysicsObject* const object);
 
             /// <summary>
-            /// Similar to addPhysicsObject(), the only difference is that the state will check the list beforehand to ensure the object isn't already on
-            /// the list.
+            /// Similar to addPhysicsObject(). Every add checks whether the object is already on the list in constant time so the two are now equivalent.
             /// </summary>
-            void addUniquePhysicsObject (PhysicsObject* const object);
+            util::SlotHandle addUniquePhysicsObject (PhysicsObject* const object)   { return addPhysicsObject (object); }
 
             /// <summary>
             /// Removes a PhysicsObject from the list of physics-managed objects. This should ALWAYS be done before deleting a PhysicsObject otherwise
@@ -126,6 +154,15 @@ namespace water
             /// <param name="object"> The object to remove, nullptr will be ignored. </param>
             void removePhysicsObject (PhysicsObject* const object);
 
+            /// <summary> Removes the PhysicsObject a handle refers to from the list of physics-managed objects. </summary>
+            /// <param name="handle"> The handle given when the object was added, stale handles will be ignored. </param>
+            void removePhysicsObject (const util::SlotHandle handle);
+
+            /// <summary> Finds the PhysicsObject a handle refers to. </summary>
+            /// <param name="handle"> The handle given when the object was added. </param>
+            /// <returns> The object, nullptr if it has been removed since the handle was given. </returns>
+            PhysicsObject* getPhysicsObject (const util::SlotHandle handle) const;
+
             /// <summary>
             /// Requests that all stored objects be removed. This is an effective method of cleaning the physics system.
             /// </summary>
@@ -140,16 +177,14 @@ namespace water
             // Let IGameWorld manage interaction with the physics system.
             friend class GameWorld;
 
-            /// <summary> Attempts to find the given PhysicsObject in the vector of objects. Don't make it const otherwise the pointer becomes const. </summary>
-            /// <param name="object"> The object to search for. </param>
-            /// <returns> The iterator of the vector for the object. </returns>
-            std::vector<PhysicsObject*>::iterator findObject (const PhysicsObject* const object);
-
             /// <summary> Obtains the collection of PhysicsObject's in the state. </summary>
-            /// <returns> A reference to the state-contained vector. </returns>
-            const std::vector<PhysicsObject*>& getPhysicsObjects() const   { return m_objects; }
+            /// <returns> A reference to the state-contained vector, the objects are packed together in no particular order. </returns>
+            const std::vector<PhysicsObject*>& getPhysicsObjects() const   { return m_objects.getValues(); }
 
-            std::vector<PhysicsObject*>    m_objects   { };    //!< A collection of PhysicsObject's to be managed by the physics system.
+            EntityWorld                                                     m_entities      { };    //!< The data-oriented entities of the state.
+            std::unique_ptr<TransformStore>                                 m_transforms    { };    //!< The position and velocity of each attached GameObject, never null.
+            util::SlotMap<PhysicsObject*>                                   m_objects       { };    //!< A collection of PhysicsObject's to be managed by the physics system.
+            std::unordered_map<const PhysicsObject*, util::SlotHandle>      m_handles       { };    //!< The handle of each object, used when objects are given by pointer.
     };
 }
 
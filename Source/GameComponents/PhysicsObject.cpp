@@ -20,13 +20,59 @@ namespace water
         {
             GameObject::operator= (std::move (move));
 
-            m_collider  = std::move (move.m_collider);
-            m_isStatic  = move.m_isStatic;
+            m_collider      = std::move (move.m_collider);
+            m_isStatic      = move.m_isStatic;
+            m_isContinuous  = move.m_isContinuous;
+            m_tilemap       = move.m_tilemap;
 
             // Reset primitives.
-            move.m_isStatic = false;
+            move.m_isStatic     = false;
+            move.m_isContinuous = false;
+            move.m_tilemap      = nullptr;
         }
 
         return *this;
     }
+
+
+    ///////////////
+    /// Setters ///
+    ///////////////
+
+    void PhysicsObject::setStatic (const bool isStatic)
+    {
+        m_isStatic = isStatic;
+
+        if (isStatic && isAttached())
+        {
+            setVelocity ({ 0.f, 0.f });
+        }
+    }
+
+
+    void PhysicsObject::setTilemap (const TilemapCollider* const tilemap)
+    {
+        m_tilemap = tilemap;
+
+        if (tilemap && isAttached())
+        {
+            setVelocity ({ 0.f, 0.f });
+        }
+    }
+
+
+    /////////////////////////
+    /// Transform storage ///
+    /////////////////////////
+
+    void PhysicsObject::attach (TransformStore& store)
+    {
+        GameObject::attach (store);
+
+        // Attached objects are always moved by their store so anything the physics system holds still mustn't keep a velocity.
+        if (isStatic() || m_isAsleep)
+        {
+            setVelocity ({ 0.f, 0.f });
+        }
+    }
 }
@@ -5,6 +5,7 @@
 // Engine headers.
 #include <GameComponents/Collider.hpp>
 #include <GameComponents/GameObject.hpp>
+#include <GameComponents/TilemapCollider.hpp>
 
 
 // Engine namespace.
@@ -40,36 +41,114 @@ namespace water
 
             /// <summary>
             /// This function is called every time two collision objects intersect. This will be called AFTER the objects have been moved
-            /// by the physics system and will be called on both objects.
+            /// by the physics system and will be called on both objects. By default this is called by onCollisionEnter() and
+            /// onCollisionStay(), so it will be called every physics update until the objects separate.
             /// </summary>
             /// <param name="collision"> The object being collided with. </param>
             virtual void onCollision (PhysicsObject* const collision) = 0;
 
             /// <summary>
             /// The function called on trigger objects when either another trigger object or a collision object intersects the trigger zone.
-            /// This will be called every frame until the object leaves.
+            /// By default this is called by onTriggerEnter() and onTriggerStay(), so it will be called every frame until the object leaves.
             /// </summary>
             /// <param name="collision"> The object intersecting the trigger zone. </param>
             virtual void onTrigger (PhysicsObject* const collision) = 0;
 
+            /// <summary> Called on both objects during the first physics update in which two collision objects intersect. </summary>
+            /// <param name="collision"> The object being collided with. </param>
+            virtual void onCollisionEnter (PhysicsObject* const collision)  { onCollision (collision); }
+
+            /// <summary>
+            /// Called on both objects during every physics update after the first in which two collision objects intersect. Stay events
+            /// can be disabled through IPhysics::setStayEvents() when only changes in contact are of interest.
+            /// </summary>
+            /// <param name="collision"> The object being collided with. </param>
+            virtual void onCollisionStay (PhysicsObject* const collision)   { onCollision (collision); }
+
+            /// <summary> Called on both objects during the first physics update in which two colliding objects no longer intersect. </summary>
+            /// <param name="collision"> The object which was being collided with, nullptr if it has been removed from the physics system. </param>
+            virtual void onCollisionExit (PhysicsObject* const)             { }
+
+            /// <summary> Called on a trigger during the first physics update in which an object intersects it. </summary>
+            /// <param name="collision"> The object intersecting the trigger zone. </param>
+            virtual void onTriggerEnter (PhysicsObject* const collision)    { onTrigger (collision); }
+
+            /// <summary> Called on a trigger during every physics update after the first in which an object intersects it. </summary>
+            /// <param name="collision"> The object intersecting the trigger zone. </param>
+            virtual void onTriggerStay (PhysicsObject* const collision)     { onTrigger (collision); }
+
+            /// <summary> Called on a trigger during the first physics update in which an object has left it. </summary>
+            /// <param name="collision"> The object which left the trigger zone, nullptr if it has been removed from the physics system. </param>
+            virtual void onTriggerExit (PhysicsObject* const)               { }
+
 
             ///////////////////////////
             /// Getters and setters ///
             ///////////////////////////
 
-            /// <summary> Indicates whether the PhysicsObject is static or not. </summary>
-            bool isStatic() const                   { return m_isStatic; }
+            /// <summary> Indicates whether the PhysicsObject is static or not, objects with a tilemap are always static. </summary>
+            bool isStatic() const                           { return m_isStatic || m_tilemap; }
+
+            /// <summary> Indicates whether the PhysicsObject uses continuous collision detection. </summary>
+            bool isContinuous() const                       { return m_isContinuous; }
+
+            /// <summary> Indicates whether the physics system has put the PhysicsObject to sleep because it stopped moving. </summary>
+            bool isAsleep() const                           { return m_isAsleep; }
 
             /// <summary>
             /// Obtain a reference to the collider of the physics object. This contains information relating to how the physics
             /// object should be handled by the engine.
             /// </summary>
             /// <returns> A reference to the collider. </returns>
-            const Collider& getCollider() const     { return m_collider; }
+            const Collider& getCollider() const             { return m_collider; }
+
+            /// <summary> Obtains the tilemap the PhysicsObject collides with instead of its collider, nullptr if it uses its collider. </summary>
+            const TilemapCollider* getTilemap() const       { return m_tilemap; }
 
-            /// <summary> Sets whether the PhysicsObject is static. If they're static they will not be moved by the physics system. </summary>
+            /// <summary>
+            /// Sets whether the PhysicsObject is static. If they're static they will not be moved by the physics system, attached objects
+            /// have their velocity cleared so their TransformStore doesn't move them either.
+            /// </summary>
             /// <param name="isStatic"> Whether it should be static. </param>
-            void setStatic (const bool isStatic)    { m_isStatic = isStatic; }
+            void setStatic (const bool isStatic);
+
+            /// <summary>
+            /// Sets whether the PhysicsObject uses continuous collision detection, this has no effect on static objects. Continuous objects
+            /// are assumed to have moved by their velocity multiplied by the physics delta during the physics update, their collider is
+            /// swept along that path so fast objects can't pass through thin objects between updates. This costs more than discrete
+            /// detection so should be reserved for small, fast objects such as bullets.
+            /// </summary>
+            /// <param name="isContinuous"> Whether it should be continuous. </param>
+            void setContinuous (const bool isContinuous)    { m_isContinuous = isContinuous; }
+
+            /// <summary>
+            /// Sets the tilemap the PhysicsObject collides with. The solid tiles replace the box of the collider, the layer of each tile
+            /// replaces the layer of the collider and the grid starts at the position of the object. The trigger flag of the collider
+            /// still applies to every tile. Objects with a tilemap are always static.
+            /// </summary>
+            /// <param name="tilemap"> The tilemap to use, nullptr to use the collider. It must outlive its use by the object. </param>
+            void setTilemap (const TilemapCollider* const tilemap);
+
+
+            /////////////////////////
+            /// Transform storage ///
+            /////////////////////////
+
+            /// <summary> Attaches the object to a TransformStore, clearing its velocity if it's static or asleep. </summary>
+            /// <param name="store"> The store to attach to. </param>
+            void attach (TransformStore& store) override;
+
+
+            ////////////////
+            /// Sleeping ///
+            ////////////////
+
+            /// <summary>
+            /// Wakes the PhysicsObject if the physics system has put it to sleep. Sleeping objects are woken automatically when they are
+            /// moved or an awake object moves into them, this should be called when giving a sleeping object velocity as velocities
+            /// are cleared while asleep if the physics system integrates them.
+            /// </summary>
+            void wake()                                     { m_isAsleep = false; m_stillSteps = 0; }
 
         protected:
 
@@ -77,8 +156,21 @@ namespace water
             /// Implementation data ///
             ///////////////////////////
 
-            Collider    m_collider  { };        //!< The collision information of the PhysicsObject.
-            bool        m_isStatic  { true };   //!< Determines whether collision should cause this object to move or not.
+            Collider                m_collider     { };         //!< The collision information of the PhysicsObject.
+            bool                    m_isStatic     { true };    //!< Determines whether collision should cause this object to move or not.
+            bool                    m_isContinuous { false };   //!< Determines whether the collider is swept along the path the object moved.
+            const TilemapCollider*  m_tilemap      { nullptr }; //!< The tiles to collide with instead of the collider, owned elsewhere.
+
+        private:
+
+            // The physics system manages the broadphase proxy of each object.
+            friend class Physics;
+
+            int             m_proxy         { -1 };     //!< The broadphase proxy of the object, this is validated by the physics system before use.
+            unsigned int    m_partition     { 0 };      //!< The broadphase partition the proxy belongs to.
+            Vector2<float>  m_rest          { 0, 0 };   //!< The position of the object at the end of the latest physics update.
+            unsigned int    m_stillSteps    { 0 };      //!< How many consecutive physics updates the object hasn't moved in.
+            bool            m_isAsleep      { false };  //!< Whether the object is asleep, sleeping objects are treated as static.
     };
 }
 
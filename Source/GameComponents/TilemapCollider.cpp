@@ -0,0 +1,221 @@
+#include "TilemapCollider.hpp"
+
+
+// STL headers.
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+
+// Engine namespace.
+namespace water
+{
+    ////////////////////
+    /// Constructors ///
+    ////////////////////
+
+    TilemapCollider::TilemapCollider (TilemapCollider&& move)
+    {
+        *this = std::move (move);
+    }
+
+
+    TilemapCollider& TilemapCollider::operator= (TilemapCollider&& move)
+    {
+        if (this != &move)
+        {
+            m_tiles     = std::move (move.m_tiles);
+            m_width     = move.m_width;
+            m_height    = move.m_height;
+            m_tileSize  = std::move (move.m_tileSize);
+            m_runs      = std::move (move.m_runs);
+            m_rows      = std::move (move.m_rows);
+            m_rowRuns   = std::move (move.m_rowRuns);
+            m_isDirty   = move.m_isDirty;
+
+            // Reset primitives.
+            move.m_width    = 0;
+            move.m_height   = 0;
+            move.m_isDirty  = false;
+        }
+
+        return *this;
+    }
+
+
+    TilemapCollider::TilemapCollider (const unsigned int width, const unsigned int height, const Vector2<float>& tileSize)
+    {
+        // Pre-condition: The tiles have an area.
+        if (!(tileSize.x > 0.f && tileSize.y > 0.f))
+        {
+            throw std::invalid_argument ("TilemapCollider::TilemapCollider(), tileSize must be above zero on both axes.");
+        }
+
+        m_tiles.assign ((size_t) width * height, 0);
+        m_width     = width;
+        m_height    = height;
+        m_tileSize  = tileSize;
+    }
+
+
+    ///////////////////////////
+    /// Getters and setters ///
+    ///////////////////////////
+
+    bool TilemapCollider::isSolid (const unsigned int x, const unsigned int y) const
+    {
+        return x < m_width && y < m_height && m_tiles[(size_t) y * m_width + x] != 0;
+    }
+
+
+    unsigned int TilemapCollider::getLayer (const unsigned int x, const unsigned int y) const
+    {
+        return isSolid (x, y) ? m_tiles[(size_t) y * m_width + x] - 1U : 0U;
+    }
+
+
+    void TilemapCollider::setTile (const unsigned int x, const unsigned int y, const bool isSolid, const unsigned int layer)
+    {
+        // Pre-condition: The tile exists.
+        if (x >= m_width || y >= m_height)
+        {
+            throw std::invalid_argument ("TilemapCollider::setTile(), the tile must be within the grid.");
+        }
+
+        auto& tile      = m_tiles[(size_t) y * m_width + x];
+        const auto next = isSolid ? (std::uint8_t) (util::min (layer, 31U) + 1) : (std::uint8_t) 0;
+
+        if (tile != next)
+        {
+            tile        = next;
+            m_isDirty   = true;
+        }
+    }
+
+
+    void TilemapCollider::clear()
+    {
+        m_tiles.assign (m_tiles.size(), 0);
+        m_isDirty = true;
+    }
+
+
+    ///////////////
+    /// Testing ///
+    ///////////////
+
+    bool TilemapCollider::overlaps (const Rectangle<float>& box, const unsigned int layers) const
+    {
+        auto found = false;
+
+        forEachTile (box, layers, [&found] (const Rectangle<float>&)
+        {
+            found = true;
+            return false;
+        });
+
+        return found;
+    }
+
+
+    const std::vector<TileRun>& TilemapCollider::getRuns() const
+    {
+        if (m_isDirty)
+        {
+            buildRuns();
+            m_isDirty = false;
+        }
+
+        return m_runs;
+    }
+
+
+    /////////////////////////
+    /// Internal workings ///
+    /////////////////////////
+
+    bool TilemapCollider::getRange (const Rectangle<float>& box, unsigned int& left, unsigned int& top, unsigned int& right,
+                                    unsigned int& bottom) const
+    {
+        const auto bounds = getBounds();
+
+        // Pre-condition: The box touches the grid. NaN values never do.
+        if (m_tiles.empty() || !box.intersects (bounds))
+        {
+            return false;
+        }
+
+        // Tiles are closed just like colliders so a box touching the edge of a tile touches that tile, this is why the lower edges
+        // round up and step back one tile. Indices are clamped before conversion so huge boxes can't overflow.
+        const auto clamp = [] (const float index, const unsigned int count)
+        {
+            return (unsigned int) util::min (util::max (index, 0.f), (float) (count - 1));
+        };
+
+        left    = clamp (std::ceil (box.getLeft() / m_tileSize.x) - 1.f, m_width);
+        top     = clamp (std::ceil (box.getTop() / m_tileSize.y) - 1.f, m_height);
+        right   = clamp (std::floor (box.getRight() / m_tileSize.x), m_width);
+        bottom  = clamp (std::floor (box.getBottom() / m_tileSize.y), m_height);
+
+        return true;
+    }
+
+
+    void TilemapCollider::buildRuns() const
+    {
+        // Each run is extended downwards while the row below contains an identical run. The runs being extended are tracked by the
+        // column they start in, so a run can only continue if the one above it started and ended in the same place.
+        std::vector<unsigned int> open ((size_t) m_width, ~0U);
+        std::vector<unsigned int> next ((size_t) m_width, ~0U);
+
+        m_runs.clear();
+        m_rows.assign ((size_t) m_height, 0);
+        m_rowRuns.clear();
+
+        for (auto y = 0U; y < m_height; ++y)
+        {
+            const auto row = m_tiles.data() + (size_t) y * m_width;
+            next.assign ((size_t) m_width, ~0U);
+
+            for (auto x = 0U; x < m_width;)
+            {
+                const auto tile = row[x];
+
+                if (tile == 0)
+                {
+                    ++x;
+                    continue;
+                }
+
+                auto end = x + 1;
+
+                while (end < m_width && row[end] == tile)
+                {
+                    ++end;
+                }
+
+                const auto right    = end * m_tileSize.x;
+                const auto above    = open[x];
+
+                if (above != ~0U && m_runs[above].box.getRight() == right && m_runs[above].layer == tile - 1U)
+                {
+                    m_runs[above].box = { m_runs[above].box.getLeft(), m_runs[above].box.getTop(), right, (y + 1) * m_tileSize.y };
+                    next[x] = above;
+                }
+
+                else
+                {
+                    next[x] = (unsigned int) m_runs.size();
+                    m_runs.push_back ({ { x * m_tileSize.x, y * m_tileSize.y, right, (y + 1) * m_tileSize.y }, tile - 1U });
+                }
+
+                // Runs are found from left to right so the runs covering each row are indexed in order.
+                m_rowRuns.push_back (next[x]);
+                x = end;
+            }
+
+            m_rows[y] = (unsigned int) m_rowRuns.size();
+            open.swap (next);
+        }
+    }
+}
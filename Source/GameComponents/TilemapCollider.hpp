@@ -0,0 +1,269 @@
+#if !defined WATER_TILEMAP_COLLIDER_INCLUDED
+#define WATER_TILEMAP_COLLIDER_INCLUDED
+
+
+// STL headers.
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+
+// Engine headers.
+#include <Misc/Rectangle.hpp>
+#include <Misc/Vector2.hpp>
+
+
+// Engine namespace.
+namespace water
+{
+    /// <summary> A rectangle of solid tiles on the same layer, produced by merging neighbouring tiles. </summary>
+    struct TileRun final
+    {
+        Rectangle<float>    box     { };    //!< The area covered by the run, relative to the origin of the tilemap.
+        unsigned int        layer   { 0 };  //!< The layer shared by every tile in the run.
+    };
+
+
+    /// <summary>
+    /// A dense grid of equally sized tiles, each of which can be solid or empty and belong to its own layer. A PhysicsObject given a
+    /// tilemap collides using the solid tiles instead of its collider, so an entire level can be registered as a single object. The
+    /// physics system only looks at the tiles covered by each object so the cost of a test depends on the size of the object rather
+    /// than the size of the map. The grid starts at the position of the object, tile (0, 0) being the top-left tile.
+    /// </summary>
+    class TilemapCollider final
+    {
+        public:
+
+            ///////////////////////////////////
+            /// Constructors and destructor ///
+            ///////////////////////////////////
+
+            TilemapCollider()                                           = default;
+            TilemapCollider (const TilemapCollider& copy)               = default;
+            TilemapCollider& operator= (const TilemapCollider& copy)    = default;
+            ~TilemapCollider()                                          = default;
+
+            TilemapCollider (TilemapCollider&& move);
+            TilemapCollider& operator= (TilemapCollider&& move);
+
+            /// <summary> Creates a tilemap where every tile is empty. </summary>
+            /// <param name="width"> The number of tiles in each row. </param>
+            /// <param name="height"> The number of rows. </param>
+            /// <param name="tileSize"> The size of every tile. Both axes must be above zero. </param>
+            TilemapCollider (const unsigned int width, const unsigned int height, const Vector2<float>& tileSize);
+
+
+            ///////////////////////////
+            /// Getters and setters ///
+            ///////////////////////////
+
+            /// <summary> Obtains the number of tiles in each row. </summary>
+            unsigned int getWidth() const                   { return m_width; }
+
+            /// <summary> Obtains the number of rows. </summary>
+            unsigned int getHeight() const                  { return m_height; }
+
+            /// <summary> Obtains the size of every tile. </summary>
+            const Vector2<float>& getTileSize() const       { return m_tileSize; }
+
+            /// <summary> Obtains the area covered by the grid, relative to the origin of the tilemap. </summary>
+            Rectangle<float> getBounds() const              { return { 0.f, 0.f, m_width * m_tileSize.x, m_height * m_tileSize.y }; }
+
+            /// <summary> Indicates whether a tile is solid, tiles outside of the grid are empty. </summary>
+            bool isSolid (const unsigned int x, const unsigned int y) const;
+
+            /// <summary> Obtains the layer of a tile, empty tiles and tiles outside of the grid are on layer zero. </summary>
+            unsigned int getLayer (const unsigned int x, const unsigned int y) const;
+
+            /// <summary> Sets whether a tile is solid and which layer it is on. </summary>
+            /// <param name="x"> The column of the tile. Must be lower than the width. </param>
+            /// <param name="y"> The row of the tile. Must be lower than the height. </param>
+            /// <param name="isSolid"> Whether objects collide with the tile. </param>
+            /// <param name="layer"> The layer of the tile, this must range from 0 to 31 to be valid. </param>
+            void setTile (const unsigned int x, const unsigned int y, const bool isSolid, const unsigned int layer = 0);
+
+            /// <summary> Makes every tile empty. </summary>
+            void clear();
+
+
+            ///////////////
+            /// Testing ///
+            ///////////////
+
+            /// <summary> Checks whether a box touches any solid tile on the given layers. </summary>
+            /// <param name="box"> The box to test, relative to the origin of the tilemap. </param>
+            /// <param name="layers"> Each bit represents a layer whose tiles should be tested. </param>
+            bool overlaps (const Rectangle<float>& box, const unsigned int layers) const;
+
+            /// <summary> Calls a function with the box of every solid tile on the given layers which a box touches, row by row. </summary>
+            /// <param name="box"> The box to test, relative to the origin of the tilemap. </param>
+            /// <param name="layers"> Each bit represents a layer whose tiles should be considered. </param>
+            /// <param name="function"> Given the box of each tile, relative to the origin of the tilemap. Returning false stops the search. </param>
+            template <typename Function> void forEachTile (const Rectangle<float>& box, const unsigned int layers, Function&& function) const;
+
+            /// <summary>
+            /// Obtains the solid tiles merged into as few rectangles as possible. Neighbouring tiles on the same layer are merged into
+            /// horizontal runs which are then merged with identical runs on the rows below. These are rebuilt when the tiles have
+            /// changed since they were last requested.
+            /// </summary>
+            const std::vector<TileRun>& getRuns() const;
+
+            /// <summary>
+            /// Finds the runs which may be crossed by a segment, visiting the rows it crosses in the order the segment crosses them and
+            /// stopping once a hit is closer than the rest of the rows. The callback determines how the segment is clipped just like
+            /// AABBTree::raycast(); returning zero stops the raycast, a negative value ignores the run and a value between zero and
+            /// one clips the segment to that fraction of its length. Runs covering several rows may be visited more than once.
+            /// </summary>
+            /// <param name="from"> The start point of the segment, relative to the origin of the tilemap. </param>
+            /// <param name="to"> The end point of the segment, relative to the origin of the tilemap. </param>
+            /// <param name="callback"> Called with each run found and the current maximum fraction of the segment. </param>
+            template <typename Function> void raycast (const Vector2<float>& from, const Vector2<float>& to, Function&& callback) const;
+
+        private:
+
+            /////////////////////////
+            /// Internal workings ///
+            /////////////////////////
+
+            /// <summary> Finds the range of tiles touched by a box, edges included. </summary>
+            /// <returns> Whether any tiles are touched, if not the range is left untouched. </returns>
+            bool getRange (const Rectangle<float>& box, unsigned int& left, unsigned int& top, unsigned int& right, unsigned int& bottom) const;
+
+            /// <summary> Merges the solid tiles into runs. </summary>
+            void buildRuns() const;
+
+
+            ///////////////////////////
+            /// Implementation data ///
+            ///////////////////////////
+
+            std::vector<std::uint8_t>          m_tiles    { };          //!< Each tile row by row, zero if empty otherwise the layer plus one.
+            unsigned int                       m_width    { 0 };        //!< The number of tiles in each row.
+            unsigned int                       m_height   { 0 };        //!< The number of rows.
+            Vector2<float>                     m_tileSize { 1.f, 1.f }; //!< The size of every tile.
+            mutable std::vector<TileRun>       m_runs     { };          //!< The solid tiles merged into rectangles.
+            mutable std::vector<unsigned int>  m_rows     { };          //!< The end of the runs of each row in m_rowRuns.
+            mutable std::vector<unsigned int>  m_rowRuns  { };          //!< The runs covering each row, sorted from left to right.
+            mutable bool                       m_isDirty  { false };    //!< Whether the tiles have changed since the runs were built.
+    };
+
+
+    /////////////////
+    /// Templates ///
+    /////////////////
+
+    template <typename Function>
+    void TilemapCollider::forEachTile (const Rectangle<float>& box, const unsigned int layers, Function&& function) const
+    {
+        auto left = 0U, top = 0U, right = 0U, bottom = 0U;
+
+        // Pre-condition: The box touches the grid.
+        if (!getRange (box, left, top, right, bottom))
+        {
+            return;
+        }
+
+        for (auto y = top; y <= bottom; ++y)
+        {
+            const auto row = m_tiles.data() + (size_t) y * m_width;
+
+            for (auto x = left; x <= right; ++x)
+            {
+                const auto tile = row[x];
+
+                if (tile != 0 && (layers & (1U << (tile - 1))) != 0)
+                {
+                    // Edges are calculated the same way for every tile so neighbouring tiles share them exactly.
+                    const auto tileBox = Rectangle<float> { x * m_tileSize.x, y * m_tileSize.y, (x + 1) * m_tileSize.x, (y + 1) * m_tileSize.y };
+
+                    if (!function (tileBox))
+                    {
+                        return;
+                    }
+                }
+            }
+        }
+    }
+
+
+    template <typename Function> void TilemapCollider::raycast (const Vector2<float>& from, const Vector2<float>& to, Function&& callback) const
+    {
+        const auto& runs    = getRuns();
+        const auto  delta   = to - from;
+        auto        left    = 0U, top = 0U, right = 0U, bottom = 0U;
+
+        // Pre-condition: The segment touches the grid.
+        if (!getRange ({ util::min (from.x, to.x), util::min (from.y, to.y), util::max (from.x, to.x), util::max (from.y, to.y) },
+                       left, top, right, bottom))
+        {
+            return;
+        }
+
+        // The spans are widened slightly so rounding can't hide a run which the segment only just touches.
+        const auto  isFlat      = std::abs (delta.y) < 1e-8f;
+        const auto  slack       = m_tileSize.x * 1e-3f;
+        auto        maxFraction = 1.f;
+
+        for (auto i = 0U; i <= bottom - top; ++i)
+        {
+            const auto row = delta.y >= 0.f ? top + i : bottom - i;
+
+            // Find the part of the segment within the row, the segment being parallel to the rows means it's within them all.
+            auto enter  = 0.f;
+            auto leave  = 1.f;
+
+            if (!isFlat)
+            {
+                enter   = (row * m_tileSize.y - from.y) / delta.y;
+                leave   = ((row + 1) * m_tileSize.y - from.y) / delta.y;
+
+                if (enter > leave)
+                {
+                    std::swap (enter, leave);
+                }
+            }
+
+            if (enter > maxFraction)
+            {
+                return;
+            }
+
+            const auto startX   = from.x + delta.x * util::max (enter, 0.f);
+            const auto endX     = from.x + delta.x * util::min (leave, maxFraction);
+            const auto lowX     = util::min (startX, endX) - slack;
+            const auto highX    = util::max (startX, endX) + slack;
+
+            // The runs of a row never overlap so they're sorted by both edges.
+            const auto begin    = m_rowRuns.begin() + (row == 0 ? 0 : m_rows[row - 1]);
+            const auto end      = m_rowRuns.begin() + m_rows[row];
+            auto       run      = std::lower_bound (begin, end, lowX, [&runs] (const unsigned int index, const float x)
+            {
+                return runs[index].box.getRight() < x;
+            });
+
+            for (; run != end && runs[*run].box.getLeft() <= highX; ++run)
+            {
+                const auto result = callback (runs[*run], maxFraction);
+
+                if (result == 0.f)
+                {
+                    return;
+                }
+
+                if (result > 0.f)
+                {
+                    maxFraction = util::min (maxFraction, result);
+                }
+            }
+
+            // Every later row is further along the segment than the end of this row.
+            if (!isFlat && maxFraction <= leave)
+            {
+                return;
+            }
+        }
+    }
+}
+
+#endif
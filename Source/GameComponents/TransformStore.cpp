@@ -0,0 +1,105 @@
+#include "TransformStore.hpp"
+
+
+// Intrinsic headers. SSE2 is guaranteed on x86-64 so only AVX must be enabled by the compiler.
+#if !defined WATER_DISABLE_SIMD
+    #if defined __AVX__
+        #define WATER_TRANSFORM_STORE_AVX
+        #include <immintrin.h>
+    #elif defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+        #define WATER_TRANSFORM_STORE_SSE
+        #include <emmintrin.h>
+    #endif
+#endif
+
+
+// Engine namespace.
+namespace water
+{
+    ///////////////////////
+    /// Data management ///
+    ///////////////////////
+
+    void TransformStore::reserve (const unsigned int capacity)
+    {
+        m_x.reserve (capacity);
+        m_y.reserve (capacity);
+        m_velocityX.reserve (capacity);
+        m_velocityY.reserve (capacity);
+    }
+
+
+    unsigned int TransformStore::add (const Vector2<float>& position, const Vector2<float>& velocity)
+    {
+        if (!m_free.empty())
+        {
+            const auto index = m_free.back();
+            m_free.pop_back();
+
+            setPosition (index, position);
+            setVelocity (index, velocity);
+
+            return index;
+        }
+
+        m_x.push_back (position.x);
+        m_y.push_back (position.y);
+        m_velocityX.push_back (velocity.x);
+        m_velocityY.push_back (velocity.y);
+
+        return (unsigned int) m_x.size() - 1;
+    }
+
+
+    void TransformStore::remove (const unsigned int index)
+    {
+        // The transform still gets integrated so it must not move.
+        setVelocity (index, { 0.f, 0.f });
+        m_free.push_back (index);
+    }
+
+
+    ///////////////////
+    /// Integration ///
+    ///////////////////
+
+    void TransformStore::integrate (const float delta)
+    {
+        // Each axis is independent so both can be processed in the same pass.
+        const auto  count       = (unsigned int) m_x.size();
+        auto        x           = m_x.data();
+        auto        y           = m_y.data();
+        const auto  velocityX   = m_velocityX.data();
+        const auto  velocityY   = m_velocityY.data();
+        auto        i           = 0U;
+
+        #if defined WATER_TRANSFORM_STORE_AVX
+
+            const auto delta8 = _mm256_set1_ps (delta);
+
+            for (; i + 8 <= count; i += 8)
+            {
+                _mm256_storeu_ps (x + i, _mm256_add_ps (_mm256_loadu_ps (x + i), _mm256_mul_ps (_mm256_loadu_ps (velocityX + i), delta8)));
+                _mm256_storeu_ps (y + i, _mm256_add_ps (_mm256_loadu_ps (y + i), _mm256_mul_ps (_mm256_loadu_ps (velocityY + i), delta8)));
+            }
+
+        #elif defined WATER_TRANSFORM_STORE_SSE
+
+            const auto delta4 = _mm_set1_ps (delta);
+
+            for (; i + 4 <= count; i += 4)
+            {
+                _mm_storeu_ps (x + i, _mm_add_ps (_mm_loadu_ps (x + i), _mm_mul_ps (_mm_loadu_ps (velocityX + i), delta4)));
+                _mm_storeu_ps (y + i, _mm_add_ps (_mm_loadu_ps (y + i), _mm_mul_ps (_mm_loadu_ps (velocityY + i), delta4)));
+            }
+
+        #endif
+
+        // Move whatever remains one at a time.
+        for (; i < count; ++i)
+        {
+            x[i] += velocityX[i] * delta;
+            y[i] += velocityY[i] * delta;
+        }
+    }
+}
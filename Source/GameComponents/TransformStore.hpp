@@ -0,0 +1,96 @@
+#if !defined WATER_TRANSFORM_STORE_INCLUDED
+#define WATER_TRANSFORM_STORE_INCLUDED
+
+
+// STL headers.
+#include <vector>
+
+
+// Engine headers.
+#include <Misc/Vector2.hpp>
+
+
+// Engine namespace.
+namespace water
+{
+    /// <summary>
+    /// Structure-of-arrays storage for the position and velocity of GameObject's. Each GameState owns a store and every object attached
+    /// to it refers to its transform by index, so moving every object is a single pass over flat arrays using SSE or AVX when available.
+    /// Define WATER_DISABLE_SIMD to force the scalar path. Indices are stable, removed transforms keep a zero velocity until they're
+    /// reused so integrating them does nothing. Attached objects point to their store so stores can't be copied or moved.
+    /// </summary>
+    class TransformStore final
+    {
+        public:
+
+            ///////////////////////////////////
+            /// Constructors and destructor ///
+            ///////////////////////////////////
+
+            TransformStore()                                        = default;
+            ~TransformStore()                                       = default;
+
+            TransformStore (const TransformStore& copy)             = delete;
+            TransformStore& operator= (const TransformStore& copy)  = delete;
+            TransformStore (TransformStore&& move)                  = delete;
+            TransformStore& operator= (TransformStore&& move)       = delete;
+
+
+            ///////////////////////////
+            /// Getters and setters ///
+            ///////////////////////////
+
+            /// <summary> Obtains the number of transforms in use. </summary>
+            unsigned int size() const                                                       { return (unsigned int) (m_x.size() - m_free.size()); }
+
+            /// <summary> Obtains the position of a transform. </summary>
+            Vector2<float> getPosition (const unsigned int index) const                     { return { m_x[index], m_y[index] }; }
+
+            /// <summary> Obtains the velocity of a transform. </summary>
+            Vector2<float> getVelocity (const unsigned int index) const                     { return { m_velocityX[index], m_velocityY[index] }; }
+
+            /// <summary> Sets the position of a transform. </summary>
+            void setPosition (const unsigned int index, const Vector2<float>& position)     { m_x[index] = position.x; m_y[index] = position.y; }
+
+            /// <summary> Sets the velocity of a transform. </summary>
+            void setVelocity (const unsigned int index, const Vector2<float>& velocity)     { m_velocityX[index] = velocity.x; m_velocityY[index] = velocity.y; }
+
+
+            ///////////////////////
+            /// Data management ///
+            ///////////////////////
+
+            /// <summary> Reserves enough memory for the given number of transforms. </summary>
+            void reserve (const unsigned int capacity);
+
+            /// <summary> Adds a transform, reusing a removed transform when possible. </summary>
+            /// <returns> The index of the transform. </returns>
+            unsigned int add (const Vector2<float>& position, const Vector2<float>& velocity);
+
+            /// <summary> Removes a transform, the index may be given to the next transform added. </summary>
+            void remove (const unsigned int index);
+
+
+            ///////////////////
+            /// Integration ///
+            ///////////////////
+
+            /// <summary> Moves every transform by its velocity. </summary>
+            /// <param name="delta"> The length of the update in seconds. </param>
+            void integrate (const float delta);
+
+        private:
+
+            ///////////////////////////
+            /// Implementation data ///
+            ///////////////////////////
+
+            std::vector<float>          m_x         { };    //!< The horizontal position of each transform.
+            std::vector<float>          m_y         { };    //!< The vertical position of each transform.
+            std::vector<float>          m_velocityX { };    //!< The horizontal velocity of each transform, zero if removed.
+            std::vector<float>          m_velocityY { };    //!< The vertical velocity of each transform, zero if removed.
+            std::vector<unsigned int>   m_free      { };    //!< The index of every removed transform.
+    };
+}
+
+#endif
@@ -2,9 +2,129 @@
 #define WATER_INTERFACE_PHYSICS_INCLUDED
 
 
+// STL headers.
+#include <functional>
+#include <vector>
+
+
+// Engine headers.
+#include <Misc/Vector2.hpp>
+
+
+// Forward declarations.
+template <typename T> class Rectangle;
+
+
 // Engine namespace.
 namespace water
 {
+    // Forward declarations.
+    class PhysicsObject;
+
+
+    /// <summary>
+    /// The result of a raycast, describing the closest object the ray hit.
+    /// </summary>
+    struct RaycastHit final
+    {
+        PhysicsObject*  object      { nullptr };    //!< The object which was hit.
+        Vector2<float>  point       { };            //!< The world-space point at which the ray entered the object.
+        Vector2<float>  normal      { };            //!< The normal of the side which was hit, zero if the ray started inside the object.
+        float           distance    { 0.f };        //!< The distance from the origin of the ray to the hit point.
+    };
+
+
+    /// <summary> An object found by a batched region query. </summary>
+    struct RegionOverlap final
+    {
+        unsigned int    region      { 0 };          //!< The index of the region which the object intersects.
+        PhysicsObject*  object      { nullptr };    //!< The object which was found.
+    };
+
+
+    /// <summary> The stages of a contact between two objects. </summary>
+    enum class ContactEvent
+    {
+        Enter,  //!< The objects started touching during the physics update.
+        Stay,   //!< The objects were already touching before the physics update.
+        Exit    //!< The objects stopped touching during the physics update.
+    };
+
+
+    /// <summary> A pair of objects in contact, given to contact handlers in batches. </summary>
+    struct ContactPair final
+    {
+        PhysicsObject*  first           { nullptr };    //!< The object on the first layer of the handler, nullptr if it has been removed.
+        PhysicsObject*  second          { nullptr };    //!< The object on the second layer of the handler, nullptr if it has been removed.
+        bool            firstTrigger    { false };      //!< Whether the collider of the first object is a trigger.
+        bool            secondTrigger   { false };      //!< Whether the collider of the second object is a trigger.
+    };
+
+
+    /// <summary>
+    /// Receives every contact of a single event between objects on a pair of layers at once. The pairs are only valid for the duration
+    /// of the call.
+    /// </summary>
+    using ContactHandler = std::function<void (const ContactEvent event, const ContactPair* const pairs, const unsigned int count)>;
+
+
+    /// <summary>
+    /// A small, fast moving circle such as a bullet or a particle. Projectiles are plain data owned by the physics system rather than
+    /// PhysicsObject's, they're moved in bulk and swept against the colliders of the objects but never against each other.
+    /// </summary>
+    struct Projectile final
+    {
+        Vector2<float>  position    { };            //!< The world-space centre of the projectile.
+        Vector2<float>  velocity    { };            //!< How far the projectile moves each second.
+        float           radius      { 0.f };        //!< The radius of the projectile, zero for a point.
+        float           lifetime    { 0.f };        //!< How many seconds remain before the projectile is removed, zero or less never expires.
+        unsigned int    layer       { 0 };          //!< The layer of the projectile, this uses the same layer masks as objects.
+        unsigned int    id          { 0 };          //!< A value chosen by the game to identify the projectile in hits.
+        bool            persistent  { false };      //!< Whether the projectile passes through what it hits rather than being removed.
+    };
+
+
+    /// <summary> A projectile touching an object during a physics update. </summary>
+    struct ProjectileHit final
+    {
+        PhysicsObject*  object      { nullptr };    //!< The object which was hit.
+        Vector2<float>  point       { };            //!< Where the centre of the projectile was when it hit.
+        Vector2<float>  normal      { };            //!< The normal of the surface which was hit, zero if the projectile started inside.
+        float           time        { 0.f };        //!< The fraction of the physics update at which the hit happened.
+        unsigned int    id          { 0 };          //!< The ID of the projectile.
+        bool            trigger     { false };      //!< Whether the collider hit is a trigger, triggers never stop a projectile.
+    };
+
+
+    /// <summary>
+    /// Measurements taken during a single physics update, used to find out whether physics is responsible for a slow frame. Counts
+    /// cover the whole update and times are in seconds.
+    /// </summary>
+    struct PhysicsStats final
+    {
+        unsigned int    objects             { 0 };      //!< The number of objects given to the update.
+        unsigned int    awake               { 0 };      //!< The number of non-static objects awake at the end of the update.
+        unsigned int    candidatePairs      { 0 };      //!< The pairs found by the broadphase whose fattened boxes overlap.
+        unsigned int    narrowphaseTests    { 0 };      //!< The colliders tested exactly, including those swept against projectiles.
+        unsigned int    overlaps            { 0 };      //!< The pairs of colliders found to overlap.
+        unsigned int    collisionCallbacks  { 0 };      //!< The onCollision*() functions called on objects.
+        unsigned int    triggerCallbacks    { 0 };      //!< The onTrigger*() functions called on objects.
+        unsigned int    handlerCalls        { 0 };      //!< The batches given to contact and projectile handlers.
+        unsigned int    projectiles         { 0 };      //!< The projectiles moved during the update.
+        unsigned int    projectileHits      { 0 };      //!< The hits reported by projectiles.
+        float           broadphaseTime      { 0.f };    //!< Spent refitting the trees and finding candidate pairs.
+        float           narrowphaseTime     { 0.f };    //!< Spent testing the candidate pairs.
+        float           solverTime          { 0.f };    //!< Spent integrating velocities, resolving penetrations and sleeping objects.
+        float           dispatchTime        { 0.f };    //!< Spent tracking contacts and calling events and handlers.
+        float           projectileTime      { 0.f };    //!< Spent moving and sweeping projectiles.
+        float           totalTime           { 0.f };    //!< Spent on the whole update.
+    };
+
+
+    /// <summary> Receives every projectile hit of a physics update at once. The hits are only valid for the duration of the call. </summary>
+    using ProjectileHandler = std::function<void (const ProjectileHit* const hits, const unsigned int count)>;
+
+
     /// <summary>
     /// An interface to every physics system in the water engine. Physics systems use layer masks to
     /// determine collision. This means each individual bit of an unsigned integer represents a collidable
@@ -36,6 +156,174 @@ namespace water
             /// <param name="layerToModify"> The layer to have its collision mask changed. Must be lower than 32. </param>
             /// <param name="layerToAdd"> The layer to remove from the collision mask, must be lower than 32. </param>
             virtual void removeFromMask (const unsigned int layerToModify, const unsigned int layerToAdd) = 0;
+
+
+            //////////////
+            /// Events ///
+            //////////////
+
+            /// <summary>
+            /// Sets whether onCollisionStay() and onTriggerStay() are called for contacts which persist between physics updates. Disabling
+            /// them means only the start and end of each contact are reported, which greatly reduces callbacks in crowded scenes.
+            /// </summary>
+            /// <param name="enabled"> Whether stay events should be delivered, they are enabled by default. </param>
+            virtual void setStayEvents (const bool enabled) = 0;
+
+            /// <summary> Indicates whether stay events are currently being delivered. </summary>
+            virtual bool hasStayEvents() const = 0;
+
+            /// <summary>
+            /// Routes the contacts between two layers to a handler instead of the event functions of each PhysicsObject. Rather than
+            /// up to two virtual calls per contact, the handler is called once per event with every contact between the layers during
+            /// the physics update. Each pair is ordered so its first object is on layerA, pairs on a single layer are in the order the
+            /// objects were given. Routed contacts are only given to the handler, neither object is notified of them. Handlers are
+            /// called after the objects in unrouted contacts have been notified of the same event, enter and stay events before any
+            /// exit events. Tilemaps are matched using the layer of their collider. Handlers must not register or remove handlers
+            /// while being called.
+            /// </summary>
+            /// <param name="layerA"> The layer of the first object in each pair. Must be lower than 32. </param>
+            /// <param name="layerB"> The layer of the second object in each pair. Must be lower than 32. </param>
+            /// <param name="handler"> The function to call, an empty function returns the contacts to the objects. </param>
+            virtual void setContactHandler (const unsigned int layerA, const unsigned int layerB, const ContactHandler& handler) = 0;
+
+
+            //////////////////
+            /// Simulation ///
+            //////////////////
+
+            /// <summary>
+            /// Sets whether the system moves every non-static object by its velocity at the start of each physics update. When disabled
+            /// objects are expected to move themselves in GameObject::updatePhysics().
+            /// </summary>
+            /// <param name="enabled"> Whether velocities should be integrated, this is disabled by default. </param>
+            virtual void setIntegration (const bool enabled) = 0;
+
+            /// <summary> Indicates whether velocities are currently being integrated. </summary>
+            virtual bool hasIntegration() const = 0;
+
+            /// <summary>
+            /// Sets whether non-static objects are pushed out of the static objects they penetrate, using the minimum translation
+            /// required. Any velocity into the static object is removed. Triggers are never resolved and collision events are called
+            /// after resolution has taken place.
+            /// </summary>
+            /// <param name="enabled"> Whether penetrations should be resolved, this is disabled by default. </param>
+            virtual void setResolution (const bool enabled) = 0;
+
+            /// <summary> Indicates whether penetrations are currently being resolved. </summary>
+            virtual bool hasResolution() const = 0;
+
+            /// <summary>
+            /// Sets how many physics updates a non-static object must stay still for before being put to sleep. Objects which touch
+            /// form islands and an island only sleeps once every object in it is still. Sleeping objects are treated as static so
+            /// they cost almost nothing, their contacts are kept without stay events being called. They wake when moved, when an awake
+            /// object moves into them or when PhysicsObject::wake() is called, moving static objects won't wake them.
+            /// </summary>
+            /// <param name="steps"> The number of still updates required, zero disables sleeping and wakes every object. </param>
+            /// <param name="tolerance"> How far an object may move during an update while still being considered still. </param>
+            virtual void setSleeping (const unsigned int steps, const float tolerance) = 0;
+
+            /// <summary> Obtains how many physics updates an object must be still for before sleeping, zero if sleeping is disabled. </summary>
+            virtual unsigned int getSleepSteps() const = 0;
+
+
+            ///////////////////
+            /// Projectiles ///
+            ///////////////////
+
+            /// <summary>
+            /// Adds a projectile to the pool. Every physics update each projectile is moved by its velocity and swept along its path
+            /// against every object on a colliding layer. A projectile which isn't persistent is removed by the first non-trigger
+            /// collider it hits, along with any triggers it passed through before that point.
+            /// </summary>
+            /// <param name="projectile"> The projectile to add, it will be copied into the pool. </param>
+            virtual void addProjectile (const Projectile& projectile) = 0;
+
+            /// <summary> Removes every projectile from the pool, reserved memory is maintained. </summary>
+            virtual void clearProjectiles() = 0;
+
+            /// <summary> Obtains how many projectiles are in the pool. </summary>
+            virtual unsigned int getProjectileCount() const = 0;
+
+            /// <summary>
+            /// Obtains every projectile hit from the most recent physics update, ordered by projectile and then by time. When several
+            /// updates are performed at once only the hits of the last are kept, a handler receives the hits of every update.
+            /// </summary>
+            virtual const std::vector<ProjectileHit>& getProjectileHits() const = 0;
+
+            /// <summary> Sets a function to be given the hits at the end of every physics update in which a projectile hit something. </summary>
+            /// <param name="handler"> The function to call, may be empty. </param>
+            virtual void setProjectileHandler (const ProjectileHandler& handler) = 0;
+
+
+            ///////////////////
+            /// Diagnostics ///
+            ///////////////////
+
+            /// <summary> Obtains the measurements taken during the most recent physics update. </summary>
+            virtual const PhysicsStats& getStats() const = 0;
+
+            /// <summary> Obtains how many threads collision detection uses, as resolved when the system was initialised. </summary>
+            virtual unsigned int getThreadCount() const = 0;
+
+            /// <summary>
+            /// Sets how many physics updates worth of measurements are kept, letting tools such as debug overlays graph recent updates
+            /// without logging. Recording a measurement never allocates.
+            /// </summary>
+            /// <param name="updates"> How many updates to keep, zero disables the history. Existing history is discarded. </param>
+            virtual void setStatsHistory (const unsigned int updates) = 0;
+
+            /// <summary> Obtains how many physics updates worth of measurements are currently kept. </summary>
+            virtual unsigned int getStatsHistorySize() const = 0;
+
+            /// <summary> Obtains the measurements of a recent physics update. </summary>
+            /// <param name="index"> Zero is the oldest update kept, must be lower than getStatsHistorySize() or std::out_of_range is thrown. </param>
+            virtual const PhysicsStats& getStatsHistory (const unsigned int index) const = 0;
+
+            /// <summary> Obtains how many non-static objects were awake at the end of the most recent physics update. </summary>
+            virtual unsigned int getAwakeCount() const = 0;
+
+            /// <summary> Obtains how many candidate pairs from the broadphase had their colliders tested during the most recent physics update. </summary>
+            virtual unsigned int getTestedPairCount() const = 0;
+
+            /// <summary> Obtains how many pairs of colliders were found to overlap during the most recent physics update. </summary>
+            virtual unsigned int getOverlapCount() const = 0;
+
+
+            ///////////////
+            /// Queries ///
+            ///////////////
+
+            /// <summary>
+            /// Finds every object whose collider intersects the given region. Queries reflect the positions of objects during the most
+            /// recent physics update, objects added or removed since then will not be accounted for.
+            /// </summary>
+            /// <param name="region"> The world-space area to search. </param>
+            /// <param name="results"> The container to fill with each object found, existing contents will be cleared. </param>
+            virtual void queryRegion (const Rectangle<float>& region, std::vector<PhysicsObject*>& results) const = 0;
+
+            /// <summary>
+            /// Performs many region queries at once, each only finding objects on layers which collide with the layer of the region.
+            /// This lets data-oriented code such as an EntityWorld check a whole array of boxes without a call per box.
+            /// </summary>
+            /// <param name="regions"> The world-space area of each query. </param>
+            /// <param name="layers"> The layer of each query, each must be lower than 32. </param>
+            /// <param name="count"> The number of queries. </param>
+            /// <param name="results"> The container to fill with each object found, ordered by region. Existing contents will be cleared. </param>
+            virtual void queryRegions (const Rectangle<float>* const regions, const unsigned int* const layers, const unsigned int count,
+                                       std::vector<RegionOverlap>& results) const = 0;
+
+            /// <summary> Finds every object whose collider contains the given point, as of the most recent physics update. </summary>
+            /// <param name="point"> The world-space point to test. </param>
+            /// <param name="results"> The container to fill with each object found, existing contents will be cleared. </param>
+            virtual void queryPoint (const Vector2<float>& point, std::vector<PhysicsObject*>& results) const = 0;
+
+            /// <summary> Casts a ray through the world, finding the closest object it hits as of the most recent physics update. </summary>
+            /// <param name="origin"> The world-space point the ray starts from. </param>
+            /// <param name="direction"> The direction of the ray, this doesn't need to be normalised. </param>
+            /// <param name="distance"> How far the ray travels. </param>
+            /// <param name="hit"> Filled with information about the closest hit, if any. </param>
+            /// <returns> Whether the ray hit anything. </returns>
+            virtual bool raycast (const Vector2<float>& origin, const Vector2<float>& direction, const float distance, RaycastHit& hit) const = 0;
     };
 }
 
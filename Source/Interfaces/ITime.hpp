@@ -13,6 +13,34 @@ using real = double;
 // Engine namespace.
 namespace water
 {
+    /// <summary>
+    /// How the time system waits at the end of a frame when no physics update or update is due yet. Spinning has the least latency
+    /// but occupies a whole core, sleeping frees the core but the operating system may wake the game late.
+    /// </summary>
+    enum class FramePacing : int
+    {
+        Spin        = 0,    //!< Don't wait, the game loop runs again immediately.
+        Yield       = 1,    //!< Yield the thread repeatedly until the next deadline.
+        Sleep       = 2,    //!< Sleep until the next deadline.
+        Adaptive    = 3     //!< Sleep until shortly before the next deadline then yield for the remainder, learning how late sleeps wake.
+    };
+
+
+    /// <summary>
+    /// Measurements of how well frames have been paced since the time system was reset. Times are in seconds.
+    /// </summary>
+    struct FrameStats final
+    {
+        unsigned int    frames          { 0 };  //!< How many frames have ended.
+        unsigned int    waits           { 0 };  //!< How many frames waited for a deadline.
+        float           averageFrame    { 0 };  //!< The average time between the end of each frame.
+        float           averageJitter   { 0 };  //!< The average time between a deadline and the wait actually ending.
+        float           maxJitter       { 0 };  //!< The largest time between a deadline and the wait actually ending.
+        float           cpuUsage        { 0 };  //!< The fraction of time the game loop thread wasn't asleep, from zero to one.
+        float           slack           { 0 };  //!< How early adaptive pacing currently wakes before a deadline.
+    };
+
+
     /// <summary>
     /// An interface to time systems, these hold delta time values as well as control the scale of time.
     /// Time classes should be used to represent the time values of the current context. In other words if deltaTime()
@@ -35,7 +63,10 @@ namespace water
             /// <returns> The physics update time during updatePhysics() or the update time during update(). </returns>
             virtual float getDelta() const = 0;
 
-            /// <summary> Get the normalised value of the current point in time between the previous physics update and the next physics update. </summary>
+            /// <summary>
+            /// Get the normalised value of the current point in time between the previous physics update and the next physics update.
+            /// This ranges from zero to one and can be used to interpolate between the previous and current physics states when rendering.
+            /// </summary>
             virtual float getPhysicsStep() const = 0;
 
             /// <summary> Obtains the time in seconds since the game start. </summary>
@@ -46,6 +77,20 @@ namespace water
 
             /// <summary> This sets the time scale applied to the real world frame times. This will not go below zero. </summary>
             virtual void setTimescale (const real timeScale) = 0;
+
+
+            ////////////////////
+            /// Frame pacing ///
+            ////////////////////
+
+            /// <summary> Obtains how the end of each frame waits for the next deadline. </summary>
+            virtual FramePacing getFramePacing() const = 0;
+
+            /// <summary> Changes how the end of each frame waits for the next deadline. </summary>
+            virtual void setFramePacing (const FramePacing pacing) = 0;
+
+            /// <summary> Obtains measurements of frame pacing since the last reset, useful for choosing a policy per machine. </summary>
+            virtual FrameStats getFrameStats() const = 0;
     };
 }
 
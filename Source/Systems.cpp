@@ -0,0 +1,20 @@
+#include "Systems.hpp"
+
+
+// Engine namespace.
+namespace water
+{
+    //////////////////////////////
+    /// Systems initial values ///
+    //////////////////////////////
+
+    // These live outside of Engine.cpp so that the game components can be linked without the rest of the engine.
+    IAudio*          Systems::m_audio        = nullptr;
+    IGameWorld*      Systems::m_gameWorld    = nullptr;
+    IInput*          Systems::m_input        = nullptr;
+    util::JobSystem* Systems::m_jobs         = nullptr;
+    ILogger*         Systems::m_logger       = nullptr;
+    IPhysics*        Systems::m_physics      = nullptr;
+    IRenderer*       Systems::m_renderer     = nullptr;
+    ITime*           Systems::m_time         = nullptr;
+}
@@ -12,6 +12,10 @@
 #include <Interfaces/ITime.hpp>
 
 
+// Forward declarations.
+namespace util { class JobSystem; }
+
+
 // Engine namespace.
 namespace water
 {
@@ -27,34 +31,37 @@ namespace water
     {
         public:
 
-            static IAudio&      audio()                                 { return *m_audio; }
-            static IGameWorld&  gameWorld()                             { return *m_gameWorld; }
-            static IInput&      input()                                 { return *m_input; }
-            static ILogger&     logger()                                { return *m_logger; }
-            static IPhysics&    physics()                               { return *m_physics; }
-            static IRenderer&   renderer()                              { return *m_renderer; }
-            static ITime&       time()                                  { return *m_time; }
+            static IAudio&           audio()                                     { return *m_audio; }
+            static IGameWorld&       gameWorld()                                 { return *m_gameWorld; }
+            static IInput&           input()                                     { return *m_input; }
+            static util::JobSystem&  jobs()                                      { return *m_jobs; }
+            static ILogger&          logger()                                    { return *m_logger; }
+            static IPhysics&         physics()                                   { return *m_physics; }
+            static IRenderer&        renderer()                                  { return *m_renderer; }
+            static ITime&            time()                                      { return *m_time; }
       
         private:
 
             /// We let the water::Engine class be a friend so that it can set the systems.
             friend class water::Engine;
 
-            static void         setAudio (IAudio* const system)         { m_audio = system; }
-            static void         setGameWorld (IGameWorld* const system) { m_gameWorld = system; }
-            static void         setInput (IInput* const system)         { m_input = system; }
-            static void         setLogger (ILogger* const system)       { m_logger = system; }
-            static void         setPhysics (IPhysics* const system)     { m_physics = system; }
-            static void         setRenderer (IRenderer* const system)   { m_renderer = system; }
-            static void         setTime (ITime* const system)           { m_time = system; }
-
-            static IAudio*      m_audio;        //!< An audio system used for playing and manipulating sounds.
-            static IGameWorld*  m_gameWorld;    //!< The game world system, allows manipulation of the game flow.
-            static IInput*      m_input;        //!< An input system for obtaining abstracted input.
-            static ILogger*     m_logger;       //!< The logger to be used for logging debug, warning or error messages.
-            static IPhysics*    m_physics;      //!< The physics system used for collision detection by games.
-            static IRenderer*   m_renderer;     //!< The renderering system which is used for drawing.
-            static ITime*       m_time;         //!< The time system which keeps track of delta time values.
+            static void              setAudio (IAudio* const system)             { m_audio = system; }
+            static void              setGameWorld (IGameWorld* const system)     { m_gameWorld = system; }
+            static void              setInput (IInput* const system)             { m_input = system; }
+            static void              setJobs (util::JobSystem* const system)     { m_jobs = system; }
+            static void              setLogger (ILogger* const system)           { m_logger = system; }
+            static void              setPhysics (IPhysics* const system)         { m_physics = system; }
+            static void              setRenderer (IRenderer* const system)       { m_renderer = system; }
+            static void              setTime (ITime* const system)               { m_time = system; }
+
+            static IAudio*           m_audio;        //!< An audio system used for playing and manipulating sounds.
+            static IGameWorld*       m_gameWorld;    //!< The game world system, allows manipulation of the game flow.
+            static IInput*           m_input;        //!< An input system for obtaining abstracted input.
+            static util::JobSystem*  m_jobs;         //!< The job system used to spread work across every core.
+            static ILogger*          m_logger;       //!< The logger to be used for logging debug, warning or error messages.
+            static IPhysics*         m_physics;      //!< The physics system used for collision detection by games.
+            static IRenderer*        m_renderer;     //!< The renderering system which is used for drawing.
+            static ITime*            m_time;         //!< The time system which keeps track of delta time values.
     };
 }
 
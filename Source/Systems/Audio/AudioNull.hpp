@@ -0,0 +1,82 @@
+#if !defined WATER_AUDIO_NULL_INCLUDED
+#define WATER_AUDIO_NULL_INCLUDED
+
+
+// Engine headers.
+#include <Systems/IEngineAudio.hpp>
+
+
+// Engine namespace
+namespace water
+{
+    /// <summary>
+    /// An audio system which plays nothing, for running without an audio device. Loading always succeeds and every ID is zero so games
+    /// behave as if audio were available.
+    /// </summary>
+    class AudioNull final : public IEngineAudio
+    {
+        public:
+
+            ///////////////////////////////////
+            /// Constructors and destructor ///
+            ///////////////////////////////////
+
+            AudioNull()                                     = default;
+            AudioNull (AudioNull&& move)                    = default;
+            AudioNull& operator= (AudioNull&& move)         = default;
+
+            ~AudioNull() override final { }
+
+            AudioNull (const AudioNull& copy)               = delete;
+            AudioNull& operator= (const AudioNull& copy)    = delete;
+
+
+            /////////////////////////
+            /// System management ///
+            /////////////////////////
+
+            void initialise (const unsigned int, const float, const float) override final                                   { }
+            void update() override final                                                                                    { }
+
+
+            ///////////////////////
+            /// Data management ///
+            ///////////////////////
+
+            bool loadMusic (const std::string&) override final                                                              { return true; }
+            SoundID loadSound (const std::string&) override final                                                           { return 0; }
+            void removeSound (const SoundID) override final                                                                 { }
+            void clearSoundData() override final                                                                            { }
+
+
+            ////////////////
+            /// Playback ///
+            ////////////////
+
+            void playMusic (const float, const float, const bool) override final                                            { }
+            void stopMusic() override final                                                                                 { }
+            void resumeMusic() override final                                                                               { }
+            void pauseMusic() override final                                                                                { }
+
+            PlaybackID playSound (const SoundID, const float, const float, const bool) override final                       { return 0; }
+            void stopSound (const PlaybackID) override final                                                                { }
+            void resumeSound (const PlaybackID) override final                                                              { }
+            void pauseSound (const PlaybackID) override final                                                               { }
+
+            void stopSounds() override final                                                                                { }
+            void resumeSounds() override final                                                                              { }
+            void pauseSounds() override final                                                                               { }
+
+
+            ////////////////////////
+            /// Sound properties ///
+            ////////////////////////
+
+            void adjustEffectsMixer (const float) override final                                                            { }
+            void adjustMusicMixer (const float) override final                                                              { }
+            void adjustMusicProperties (const float, const float, const bool) override final                                { }
+            void adjustSoundProperties (const PlaybackID, const float, const float, const bool) override final              { }
+    };
+}
+
+#endif
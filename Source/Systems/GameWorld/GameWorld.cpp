@@ -4,6 +4,7 @@
 // Engine headers.
 #include <GameComponents/GameState.hpp>
 #include <Systems.hpp>
+#include <Utility/Profiler.hpp>
 
 
 // Engine namespace.
@@ -50,7 +51,23 @@ namespace water
     {
         if (!m_stack.empty())
         {
-            m_stack.top()->updatePhysics();
+            // Attached objects and entities are moved once the state has had its say, entity contacts reflect the objects as of the
+            // previous physics update.
+            auto&       state   = *m_stack.top();
+            const auto  delta   = Systems::time().getDelta();
+
+            state.updatePhysics();
+
+            if (state.m_transforms->size() != 0)
+            {
+                state.m_transforms->integrate (delta);
+            }
+
+            if (!state.m_entities.isEmpty())
+            {
+                state.m_entities.integrate (delta);
+                state.m_entities.findContacts (Systems::physics());
+            }
         }
     }
 
@@ -68,13 +85,21 @@ namespace water
     {
         if (!m_stack.empty())
         {
-            m_stack.top()->render();
+            auto& state = *m_stack.top();
+            state.render();
+
+            if (!state.m_entities.isEmpty())
+            {
+                state.m_entities.render (Systems::renderer());
+            }
         }
     }
 
 
     void GameWorld::processQueue()
     {
+        WATER_PROFILE_ZONE ("Process queue");
+
         // Iterate through the queue performing the specified task.
         while (!m_tasks.empty())
         {
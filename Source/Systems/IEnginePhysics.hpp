@@ -3,6 +3,7 @@
 
 
 // STL headers.
+#include <functional>
 #include <vector>
 
 
@@ -10,6 +11,10 @@
 #include <Interfaces/IPhysics.hpp>
 
 
+// Forward declarations.
+namespace util { class JobSystem; }
+
+
 // Engine namespace.
 namespace water
 {
@@ -33,11 +38,29 @@ namespace water
             /////////////////////////
 
             /// <summary> Initialise the system, preparing it for checking collisions. </summary>
-            virtual void initialise() = 0;
+            /// <param name="margin"> How far objects may move before the broadphase tree needs restructuring. </param>
+            /// <param name="jobs">
+            /// The job system to spread collision detection across, nullptr runs it all on the calling thread. Collision detection must
+            /// then be run by the thread which created the job system or by one of its jobs.
+            /// </param>
+            virtual void initialise (const float margin, util::JobSystem* const jobs) = 0;
 
             /// <summary> Checks for collisions in all given PhysicsObject's. </summary>
             /// <param name="objects"> The objects to check collision for. </param>
-            virtual void detectCollisions (const std::vector<PhysicsObject*>& objects) = 0;
+            /// <param name="delta"> The length of the physics update in seconds, used to find where continuous objects moved from. </param>
+            virtual void detectCollisions (const std::vector<PhysicsObject*>& objects, const float delta) = 0;
+
+            /// <summary>
+            /// Performs several fixed physics updates back to back, as required when the game needs to catch up after a slow frame.
+            /// Each step calls the given function, letting objects move, then checks for collisions just like detectCollisions(). It is
+            /// equivalent to calling both in a loop and exists so the caller doesn't need to.
+            /// </summary>
+            /// <param name="objects"> The objects to check collision for, the collection may change between steps. </param>
+            /// <param name="delta"> The length of each physics update in seconds. </param>
+            /// <param name="steps"> The number of physics updates to perform. </param>
+            /// <param name="beforeStep"> Called at the start of every step, may be empty. </param>
+            virtual void simulate (const std::vector<PhysicsObject*>& objects, const float delta, const unsigned int steps,
+                                   const std::function<void()>& beforeStep) = 0;
     };
 }
 
@@ -34,14 +34,14 @@ namespace water
             virtual void initialise (const unsigned int physicsFPS, const unsigned int updateFPS, const unsigned int minFPS) = 0;
 
             /// <summary> Causes physics update to become the active context and updates the physics delta time. </summary>
-            /// <returns> Whether an update should be performed on physics systems this frame. </returns>
-            virtual bool updatePhysics() = 0;
+            /// <returns> How many fixed updates should be performed on physics systems this frame, this is capped by the minimum FPS. </returns>
+            virtual unsigned int updatePhysics() = 0;
 
             /// <summary> Causes update to become the active context and updates the standard delta time. </summary>
             /// <returns> Whether an update should be performed on game objects. </returns>
             virtual bool update() = 0;
 
-            /// <summary> Causes the time system to perform end-of-frame actions such as decrementing accumulators. </summary>
+            /// <summary> Causes the time system to perform end-of-frame actions such as decrementing accumulators and pacing the frame. </summary>
             virtual void endFrame() = 0;
 
             /// <summary> Force the time class to reset the start time, this is useful to avoid initialisation effecting time values. </summary>
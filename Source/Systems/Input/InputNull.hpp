@@ -0,0 +1,77 @@
+#if !defined WATER_INPUT_NULL_INCLUDED
+#define WATER_INPUT_NULL_INCLUDED
+
+
+// Engine headers.
+#include <Systems/IEngineInput.hpp>
+
+
+// Engine namespace.
+namespace water
+{
+    /// <summary>
+    /// An input system with no devices, for running without a window or controllers. Actions can be added but are never pressed and no
+    /// controllers are ever connected.
+    /// </summary>
+    class InputNull final : public IEngineInput
+    {
+        public:
+
+            ///////////////////////////////////
+            /// Constructors and destructor ///
+            ///////////////////////////////////
+
+            InputNull()                                     = default;
+            InputNull (InputNull&& move)                    = default;
+            InputNull& operator= (InputNull&& move)         = default;
+
+            ~InputNull() override final { }
+
+            InputNull (const InputNull& copy)               = delete;
+            InputNull& operator= (const InputNull& copy)    = delete;
+
+
+            /////////////////////////
+            /// System management ///
+            /////////////////////////
+
+            void initialise() override final                                                                    { }
+            void update() override final                                                                        { }
+
+
+            ///////////////
+            /// Getters ///
+            ///////////////
+
+            bool isConnected (const unsigned int) const override final                                          { return false; }
+            bool hasAxis (const unsigned int, const Axis) const override final                                  { return false; }
+            unsigned int getButtonCount (const unsigned int) const override final                               { return 0; }
+            unsigned int getKeyCount() const override final                                                     { return 0; }
+            bool getActionPressed (const int) const override final                                              { return false; }
+            bool getActionUp (const int) const override final                                                   { return false; }
+            bool getActionDown (const int) const override final                                                 { return false; }
+            float getActionAxis (const int) const override final                                                { return 0.f; }
+
+
+            ///////////////////////
+            /// Real-time state ///
+            ///////////////////////
+
+            bool isKeyPressed (const Key) const override final                                                  { return false; }
+            bool isButtonPressed (const unsigned int, const unsigned int) const override final                  { return false; }
+            float axisPosition (const unsigned int, const Axis) const override final                            { return 0.f; }
+
+
+            /////////////////////////
+            /// Action management ///
+            /////////////////////////
+
+            bool addAction (const KeyboardKey&) override final                                                  { return true; }
+            bool addAction (const ControllerButton&) override final                                             { return true; }
+            bool addAction (const ControllerAxis&) override final                                               { return true; }
+            void removeAction (const int, const Action) override final                                          { }
+            void removeActions() override final                                                                 { }
+    };
+}
+
+#endif
@@ -6,6 +6,7 @@
 
 
 // Engine headers.
+#include <Utility/Profiler.hpp>
 #include <Utility/Time.hpp>
 
 
@@ -151,6 +152,9 @@ namespace water
 
     bool LoggerSTL::outputToStream (const std::string& name, const std::string& output)
     {
+        // Every message reopens the file so logging can be surprisingly expensive.
+        WATER_PROFILE_ZONE ("Log");
+
         // Be careful when dealing with file handling.
         try
         {
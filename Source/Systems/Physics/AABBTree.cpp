@@ -0,0 +1,484 @@
+#include "AABBTree.hpp"
+
+
+// STL headers.
+#include <utility>
+
+
+// Engine headers.
+#include <Utility/Maths.hpp>
+
+
+// Engine namespace.
+namespace water
+{
+    ///////////////////////////////////
+    /// Constructors and destructor ///
+    ///////////////////////////////////
+
+    AABBTree::AABBTree (const float margin)
+    {
+        setMargin (margin);
+    }
+
+
+    AABBTree::AABBTree (AABBTree&& move)
+    {
+        *this = std::move (move);
+    }
+
+
+    AABBTree& AABBTree::operator= (AABBTree&& move)
+    {
+        if (this != &move)
+        {
+            m_nodes     = std::move (move.m_nodes);
+            m_root      = move.m_root;
+            m_free      = move.m_free;
+            m_margin    = move.m_margin;
+
+            // Reset primitives.
+            move.m_root     = null;
+            move.m_free     = null;
+            move.m_margin   = 0.f;
+        }
+
+        return *this;
+    }
+
+
+    ///////////////////////////
+    /// Getters and setters ///
+    ///////////////////////////
+
+    void AABBTree::setMargin (const float margin)
+    {
+        m_margin = util::max (margin, 0.f);
+    }
+
+
+    ////////////////////////
+    /// Proxy management ///
+    ////////////////////////
+
+    int AABBTree::createProxy (const Rectangle<float>& box)
+    {
+        const auto proxy = allocateNode();
+
+        // Fatten the box so small movements don't require the tree to be modified.
+        auto& node  = m_nodes[proxy];
+        node.box    = { box.getLeft() - m_margin, box.getTop() - m_margin, box.getRight() + m_margin, box.getBottom() + m_margin };
+        node.height = 0;
+
+        insertLeaf (proxy);
+
+        return proxy;
+    }
+
+
+    void AABBTree::destroyProxy (const int proxy)
+    {
+        removeLeaf (proxy);
+        freeNode (proxy);
+    }
+
+
+    bool AABBTree::moveProxy (const int proxy, const Rectangle<float>& box)
+    {
+        // Nothing needs to change if the proxy is still contained by its fattened box.
+        if (m_nodes[proxy].box.contains (box))
+        {
+            return false;
+        }
+
+        removeLeaf (proxy);
+
+        m_nodes[proxy].box = { box.getLeft() - m_margin, box.getTop() - m_margin, box.getRight() + m_margin, box.getBottom() + m_margin };
+
+        insertLeaf (proxy);
+
+        return true;
+    }
+
+
+    void AABBTree::clear()
+    {
+        // Rebuild the free list through every node.
+        for (auto i = 0U; i < m_nodes.size(); ++i)
+        {
+            m_nodes[i].parent = i + 1 < m_nodes.size() ? (int) i + 1 : null;
+            m_nodes[i].height = -1;
+        }
+
+        m_root = null;
+        m_free = m_nodes.empty() ? null : 0;
+    }
+
+
+    ///////////////
+    /// Queries ///
+    ///////////////
+
+    void AABBTree::splitPairs (const AABBTree& other, const unsigned int minimum, std::vector<std::pair<int, int>>& tasks) const
+    {
+        tasks.clear();
+
+        if (m_root == null || other.m_root == null)
+        {
+            return;
+        }
+
+        // Expand the traversal a level at a time so the tasks remain of a similar size. Intersecting leaves are kept as tasks of their own.
+        std::vector<std::pair<int, int>>    next        { };
+        std::pair<int, int>                 children[3] { };
+        auto                                expanded    = true;
+
+        tasks.push_back ({ m_root, other.m_root });
+
+        while (expanded && tasks.size() < minimum)
+        {
+            expanded = false;
+            next.clear();
+
+            for (const auto& task : tasks)
+            {
+                const auto count = expandPair (other, task, children);
+
+                if (count < 0)
+                {
+                    next.push_back (task);
+                }
+
+                else
+                {
+                    next.insert (next.end(), children, children + count);
+                    expanded = true;
+                }
+            }
+
+            tasks.swap (next);
+        }
+    }
+
+
+    /////////////////////////
+    /// Internal workings ///
+    /////////////////////////
+
+    int AABBTree::allocateNode()
+    {
+        // Grow the pool if we've ran out of nodes.
+        if (m_free == null)
+        {
+            m_nodes.emplace_back();
+            m_free = (int) m_nodes.size() - 1;
+            m_nodes.back().parent = null;
+        }
+
+        // Take the node from the free list.
+        const auto node = m_free;
+        auto& data      = m_nodes[node];
+        m_free          = data.parent;
+
+        data.parent     = null;
+        data.child1     = null;
+        data.child2     = null;
+        data.height     = 0;
+
+        return node;
+    }
+
+
+    void AABBTree::freeNode (const int node)
+    {
+        m_nodes[node].parent    = m_free;
+        m_nodes[node].height    = -1;
+        m_free                  = node;
+    }
+
+
+    void AABBTree::insertLeaf (const int leaf)
+    {
+        // Pre-condition: The tree isn't empty.
+        if (m_root == null)
+        {
+            m_root = leaf;
+            m_nodes[leaf].parent = null;
+            return;
+        }
+
+        const auto leafBox  = m_nodes[leaf].box;
+        const auto sibling  = findBestSibling (leafBox);
+
+        // Create a new parent for the sibling and the leaf. Allocation may resize the pool so avoid holding references.
+        const auto oldParent    = m_nodes[sibling].parent;
+        const auto newParent    = allocateNode();
+
+        m_nodes[newParent].parent   = oldParent;
+        m_nodes[newParent].box      = combine (leafBox, m_nodes[sibling].box);
+        m_nodes[newParent].height   = m_nodes[sibling].height + 1;
+        m_nodes[newParent].child1   = sibling;
+        m_nodes[newParent].child2   = leaf;
+        m_nodes[sibling].parent     = newParent;
+        m_nodes[leaf].parent        = newParent;
+
+        if (oldParent != null)
+        {
+            if (m_nodes[oldParent].child1 == sibling)
+            {
+                m_nodes[oldParent].child1 = newParent;
+            }
+
+            else
+            {
+                m_nodes[oldParent].child2 = newParent;
+            }
+        }
+
+        else
+        {
+            m_root = newParent;
+        }
+
+        // Walk back up the tree fixing heights and boxes.
+        refit (m_nodes[leaf].parent);
+    }
+
+
+    void AABBTree::removeLeaf (const int leaf)
+    {
+        if (leaf == m_root)
+        {
+            m_root = null;
+            return;
+        }
+
+        const auto parent       = m_nodes[leaf].parent;
+        const auto grandParent  = m_nodes[parent].parent;
+        const auto sibling      = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+        // The sibling takes the place of the parent.
+        if (grandParent != null)
+        {
+            if (m_nodes[grandParent].child1 == parent)
+            {
+                m_nodes[grandParent].child1 = sibling;
+            }
+
+            else
+            {
+                m_nodes[grandParent].child2 = sibling;
+            }
+
+            m_nodes[sibling].parent = grandParent;
+            freeNode (parent);
+
+            refit (grandParent);
+        }
+
+        else
+        {
+            m_root = sibling;
+            m_nodes[sibling].parent = null;
+            freeNode (parent);
+        }
+    }
+
+
+    int AABBTree::findBestSibling (const Rectangle<float>& box) const
+    {
+        // This is a branch and bound search. The cost of choosing a node as the sibling is the perimeter of the new parent plus the
+        // growth of every ancestor, the search only descends into a child when it could lead to a cheaper sibling than the best so far.
+        const auto  boxArea         = perimeter (box);
+        auto        index           = m_root;
+        auto        area            = perimeter (m_nodes[m_root].box);
+        auto        directCost      = perimeter (combine (m_nodes[m_root].box, box));
+        auto        inheritedCost   = 0.f;
+        auto        best            = m_root;
+        auto        bestCost        = directCost;
+
+        while (!m_nodes[index].isLeaf())
+        {
+            const auto& node = m_nodes[index];
+
+            if (directCost + inheritedCost < bestCost)
+            {
+                best        = index;
+                bestCost    = directCost + inheritedCost;
+            }
+
+            // Every descendant of this node will cause it to grow by the same amount.
+            inheritedCost += directCost - area;
+
+            // Calculate the cost of each child and the lowest cost any of their descendants could have.
+            struct Candidate final
+            {
+                int     index;
+                bool    isLeaf;
+                float   area;
+                float   directCost;
+                float   lowerBound;
+            };
+
+            const auto evaluate = [&] (const int child)
+            {
+                const auto& data        = m_nodes[child];
+                auto        candidate   = Candidate { child, data.isLeaf(), perimeter (data.box), perimeter (combine (data.box, box)), 0.f };
+
+                if (candidate.isLeaf)
+                {
+                    if (candidate.directCost + inheritedCost < bestCost)
+                    {
+                        best        = child;
+                        bestCost    = candidate.directCost + inheritedCost;
+                    }
+                }
+
+                else
+                {
+                    candidate.lowerBound = inheritedCost + candidate.directCost + util::min (boxArea - candidate.area, 0.f);
+                }
+
+                return candidate;
+            };
+
+            const auto child1 = evaluate (node.child1);
+            const auto child2 = evaluate (node.child2);
+
+            // Stop when neither child can lead to a cheaper sibling.
+            const auto descend1 = !child1.isLeaf && child1.lowerBound < bestCost;
+            const auto descend2 = !child2.isLeaf && child2.lowerBound < bestCost;
+
+            if (!descend1 && !descend2)
+            {
+                break;
+            }
+
+            const auto& next = descend1 && (!descend2 || child1.lowerBound <= child2.lowerBound) ? child1 : child2;
+
+            index       = next.index;
+            area        = next.area;
+            directCost  = next.directCost;
+        }
+
+        return best;
+    }
+
+
+    void AABBTree::rotate (const int a)
+    {
+        // Pre-condition: The node has grandchildren.
+        if (m_nodes[a].height < 2)
+        {
+            return;
+        }
+
+        // A has children B and C, B has children D and E whilst C has children F and G.
+        // Swapping B with F or G, or C with D or E, only changes the box of C or B respectively. Choose the swap which shrinks it the most.
+        const auto  b           = m_nodes[a].child1;
+        const auto  c           = m_nodes[a].child2;
+        const auto& nodeB       = m_nodes[b];
+        const auto& nodeC       = m_nodes[c];
+        auto        bestGain    = 0.f;
+        auto        bestChild   = null;
+        auto        bestGrand   = null;
+
+        const auto consider = [&] (const int child, const Node& sibling)
+        {
+            const auto area = perimeter (sibling.box);
+
+            for (const auto grand : { sibling.child1, sibling.child2 })
+            {
+                const auto kept = grand == sibling.child1 ? sibling.child2 : sibling.child1;
+                const auto gain = area - perimeter (combine (m_nodes[child].box, m_nodes[kept].box));
+
+                if (gain > bestGain)
+                {
+                    bestGain    = gain;
+                    bestChild   = child;
+                    bestGrand   = grand;
+                }
+            }
+        };
+
+        if (!nodeC.isLeaf())
+        {
+            consider (b, nodeC);
+        }
+
+        if (!nodeB.isLeaf())
+        {
+            consider (c, nodeB);
+        }
+
+        if (bestChild == null)
+        {
+            return;
+        }
+
+        // Swap the child and the grandchild, then refit the node which has gained the child.
+        const auto  owner       = bestChild == b ? c : b;
+        auto&       nodeA       = m_nodes[a];
+        auto&       nodeOwner   = m_nodes[owner];
+        const auto  kept        = nodeOwner.child1 == bestGrand ? nodeOwner.child2 : nodeOwner.child1;
+
+        if (nodeA.child1 == bestChild)
+        {
+            nodeA.child1 = bestGrand;
+        }
+
+        else
+        {
+            nodeA.child2 = bestGrand;
+        }
+
+        if (nodeOwner.child1 == bestGrand)
+        {
+            nodeOwner.child1 = bestChild;
+        }
+
+        else
+        {
+            nodeOwner.child2 = bestChild;
+        }
+
+        m_nodes[bestGrand].parent   = a;
+        m_nodes[bestChild].parent   = owner;
+        nodeOwner.box               = combine (m_nodes[bestChild].box, m_nodes[kept].box);
+        nodeOwner.height            = 1 + util::max (m_nodes[bestChild].height, m_nodes[kept].height);
+    }
+
+
+    void AABBTree::refit (int node)
+    {
+        while (node != null)
+        {
+            rotate (node);
+
+            auto&       data    = m_nodes[node];
+            const auto& child1  = m_nodes[data.child1];
+            const auto& child2  = m_nodes[data.child2];
+
+            data.height = 1 + util::max (child1.height, child2.height);
+            data.box    = combine (child1.box, child2.box);
+
+            node = data.parent;
+        }
+    }
+
+
+    Rectangle<float> AABBTree::combine (const Rectangle<float>& a, const Rectangle<float>& b)
+    {
+        return {    util::min (a.getLeft(), b.getLeft()),
+                    util::min (a.getTop(), b.getTop()),
+                    util::max (a.getRight(), b.getRight()),
+                    util::max (a.getBottom(), b.getBottom())    };
+    }
+
+
+    float AABBTree::perimeter (const Rectangle<float>& box)
+    {
+        // Rectangle::perimeter() treats the edges as inclusive pixels, we want the continuous perimeter here.
+        return 2.f * ((box.getRight() - box.getLeft()) + (box.getBottom() - box.getTop()));
+    }
+}
@@ -0,0 +1,432 @@
+#if !defined WATER_AABB_TREE_INCLUDED
+#define WATER_AABB_TREE_INCLUDED
+
+
+// STL headers.
+#include <utility>
+#include <vector>
+
+
+// Engine headers.
+#include <Misc/Rectangle.hpp>
+#include <Misc/Vector2.hpp>
+
+
+// Engine namespace.
+namespace water
+{
+    /// <summary>
+    /// A dynamic bounding volume hierarchy of axis-aligned boxes. Each proxy in the tree is a leaf whose box has been fattened by a
+    /// margin, this allows small movements to be absorbed without restructuring the tree. Leaves are inserted where they increase the
+    /// total perimeter of the tree the least and rotations are performed on the way back up, keeping queries fast as proxies are added,
+    /// moved and removed. Proxies are identified by the index of their node.
+    /// </summary>
+    class AABBTree final
+    {
+        public:
+
+            ///////////////////////////////////
+            /// Constructors and destructor ///
+            ///////////////////////////////////
+
+            /// <summary> Construct an empty tree. </summary>
+            /// <param name="margin"> How far each proxy is fattened in every direction. </param>
+            AABBTree (const float margin = 0.f);
+
+            AABBTree (const AABBTree& copy)             = default;
+            AABBTree& operator= (const AABBTree& copy)  = default;
+            ~AABBTree()                                 = default;
+
+            AABBTree (AABBTree&& move);
+            AABBTree& operator= (AABBTree&& move);
+
+
+            ///////////////////////////
+            /// Getters and setters ///
+            ///////////////////////////
+
+            /// <summary> Obtains the fattened box of a proxy. </summary>
+            const Rectangle<float>& getFatBox (const int proxy) const   { return m_nodes[proxy].box; }
+
+            /// <summary> Obtains the number of nodes the tree has allocated, every proxy ID will be lower than this. </summary>
+            int getCapacity() const                                     { return (int) m_nodes.size(); }
+
+            /// <summary> Obtains the height of the tree, zero if the tree is empty or contains a single proxy. </summary>
+            int getHeight() const                                       { return m_root == null ? 0 : m_nodes[m_root].height; }
+
+            /// <summary> Obtains how far each proxy is fattened in every direction. </summary>
+            float getMargin() const                                     { return m_margin; }
+
+            /// <summary> Sets how far proxies are fattened. This will only apply to proxies which are created or moved afterwards. </summary>
+            /// <param name="margin"> The desired margin, negative values will be treated as zero. </param>
+            void setMargin (const float margin);
+
+
+            ////////////////////////
+            /// Proxy management ///
+            ////////////////////////
+
+            /// <summary> Creates a proxy for the given box. </summary>
+            /// <param name="box"> The tight box of the proxy, this will be fattened by the margin. </param>
+            /// <returns> The ID of the proxy. </returns>
+            int createProxy (const Rectangle<float>& box);
+
+            /// <summary> Removes a proxy from the tree, its ID may be reused by future proxies. </summary>
+            /// <param name="proxy"> The ID of a valid proxy. </param>
+            void destroyProxy (const int proxy);
+
+            /// <summary> Updates the box of a proxy. The tree is only modified if the box has escaped the fattened box of the proxy. </summary>
+            /// <param name="proxy"> The ID of a valid proxy. </param>
+            /// <param name="box"> The new tight box of the proxy. </param>
+            /// <returns> Whether the proxy had to be reinserted. </returns>
+            bool moveProxy (const int proxy, const Rectangle<float>& box);
+
+            /// <summary> Removes every proxy from the tree, invalidating every ID. Reserved memory is maintained. </summary>
+            void clear();
+
+
+            ///////////////
+            /// Queries ///
+            ///////////////
+
+            /// <summary> Finds every proxy whose fattened box intersects the given box. </summary>
+            /// <param name="box"> The area to search. </param>
+            /// <param name="callback"> Called with the ID of each proxy found, return false to stop the query. </param>
+            template <typename Function> void query (const Rectangle<float>& box, Function&& callback) const;
+
+            /// <summary>
+            /// Finds every pair of proxies whose fattened boxes intersect by traversing two trees against each other. If the other tree
+            /// is this tree then every overlapping pair within it is found instead.
+            /// </summary>
+            /// <param name="other"> The tree to test against, the second ID of each pair belongs to this tree. </param>
+            /// <param name="callback"> Called with the IDs of both proxies in each pair found, each pair is reported once. </param>
+            template <typename Function> void queryPairs (const AABBTree& other, Function&& callback) const;
+
+            /// <summary>
+            /// Splits the traversal performed by queryPairs() into independent tasks so that pairs can be found on multiple threads.
+            /// Running every task with the same trees finds exactly the same pairs as a single traversal.
+            /// </summary>
+            /// <param name="other"> The tree to test against, this may be this tree. </param>
+            /// <param name="minimum"> The desired number of tasks, fewer will be produced if the trees are small. </param>
+            /// <param name="tasks"> Filled with the tasks, existing contents will be cleared. </param>
+            void splitPairs (const AABBTree& other, const unsigned int minimum, std::vector<std::pair<int, int>>& tasks) const;
+
+            /// <summary> Performs a single task produced by splitPairs(), finding every pair of proxies within it. </summary>
+            /// <param name="other"> The tree given to splitPairs(). </param>
+            /// <param name="task"> The task to perform. </param>
+            /// <param name="callback"> Called with the IDs of both proxies in each pair found, the second ID belongs to the other tree. </param>
+            template <typename Function> void queryPairs (const AABBTree& other, const std::pair<int, int>& task, Function&& callback) const;
+
+            /// <summary>
+            /// Finds every proxy whose fattened box is crossed by the segment between the two given points. The callback determines how
+            /// the ray is clipped; returning zero stops the raycast, a negative value ignores the proxy and a value between zero and one
+            /// clips the ray to that fraction of its length, allowing the closest hit to be found quickly.
+            /// </summary>
+            /// <param name="from"> The start point of the segment. </param>
+            /// <param name="to"> The end point of the segment. </param>
+            /// <param name="callback"> Called with the ID of each proxy found and the current maximum fraction of the segment. </param>
+            template <typename Function> void raycast (const Vector2<float>& from, const Vector2<float>& to, Function&& callback) const;
+
+        private:
+
+            static const int null       = -1;   //!< Represents the absence of a node.
+            static const int stackSize  = 256;  //!< How many entries a traversal stack can hold before it must use the heap.
+
+
+            /// <summary> A traversal stack which lives on the call stack, only using the heap if the tree is unusually deep. </summary>
+            template <typename T> class Stack final
+            {
+                public:
+
+                    Stack()                                 = default;
+                    Stack (const Stack& copy)               = delete;
+                    Stack& operator= (const Stack& copy)    = delete;
+
+                    bool isEmpty() const    { return m_size == 0; }
+
+                    T pop()                 { return m_data[--m_size]; }
+
+                    void push (const T& value)
+                    {
+                        if (m_size == m_capacity)
+                        {
+                            m_heap.assign (m_data, m_data + m_size);
+                            m_heap.resize (m_capacity * 2);
+                            m_data      = m_heap.data();
+                            m_capacity  = (int) m_heap.size();
+                        }
+
+                        m_data[m_size++] = value;
+                    }
+
+                private:
+
+                    T               m_local[stackSize];         //!< The initial storage of the stack.
+                    std::vector<T>  m_heap      { };            //!< The storage used when the local storage is exhausted.
+                    T*              m_data      { m_local };    //!< The storage currently in use.
+                    int             m_size      { 0 };          //!< The number of entries on the stack.
+                    int             m_capacity  { stackSize };  //!< The number of entries the current storage can hold.
+            };
+
+
+            /// <summary> A node in the tree. Leaves represent proxies, branches always have two children. </summary>
+            struct Node final
+            {
+                Rectangle<float>    box     { };        //!< The box containing every descendant, fattened for leaves.
+                int                 parent  { null };   //!< The parent of the node, or the next free node when unused.
+                int                 child1  { null };   //!< The first child of the node.
+                int                 child2  { null };   //!< The second child of the node.
+                int                 height  { -1 };     //!< Zero for leaves, -1 for unused nodes.
+
+                bool isLeaf() const { return child1 == null; }
+            };
+
+
+            /////////////////////////
+            /// Internal workings ///
+            /////////////////////////
+
+            /// <summary> Expands an entry of a pair traversal into the entries which must be tested next. </summary>
+            /// <param name="other"> The tree the second node of each entry belongs to. </param>
+            /// <param name="entry"> A node from each tree, if both are the same node of this tree its children are tested against each other. </param>
+            /// <param name="children"> Filled with up to three entries to test next. </param>
+            /// <returns> How many entries were written, or -1 if the entry is a pair of intersecting leaves. </returns>
+            int expandPair (const AABBTree& other, const std::pair<int, int>& entry, std::pair<int, int>* const children) const;
+
+            /// <summary> Obtains an unused node, growing the pool if necessary. </summary>
+            int allocateNode();
+
+            /// <summary> Returns a node to the free list. </summary>
+            void freeNode (const int node);
+
+            /// <summary> Inserts a leaf into the tree at the position which increases the total perimeter the least. </summary>
+            void insertLeaf (const int leaf);
+
+            /// <summary> Removes a leaf from the tree, the node itself is not freed. </summary>
+            void removeLeaf (const int leaf);
+
+            /// <summary> Finds the sibling which minimises the increase in perimeter of the tree when a leaf with the given box is added. </summary>
+            int findBestSibling (const Rectangle<float>& box) const;
+
+            /// <summary> Swaps a child of the given node with a grandchild if it reduces the perimeter of the tree. </summary>
+            void rotate (const int node);
+
+            /// <summary> Refits the box and height of the given node and every ancestor, rotating along the way. </summary>
+            void refit (int node);
+
+            /// <summary> Creates the smallest box which contains both the given boxes. </summary>
+            static Rectangle<float> combine (const Rectangle<float>& a, const Rectangle<float>& b);
+
+            /// <summary> Calculates the perimeter of a box, used as the cost heuristic when inserting. </summary>
+            static float perimeter (const Rectangle<float>& box);
+
+
+            ///////////////////////////
+            /// Implementation data ///
+            ///////////////////////////
+
+            std::vector<Node>   m_nodes     { };        //!< The pool of nodes, both used and unused.
+            int                 m_root      { null };   //!< The root node of the tree.
+            int                 m_free      { null };   //!< The first node of the free list.
+            float               m_margin    { 0.f };    //!< How far proxies are fattened in each direction.
+    };
+
+
+    ///////////////
+    /// Queries ///
+    ///////////////
+
+    template <typename Function> void AABBTree::query (const Rectangle<float>& box, Function&& callback) const
+    {
+        // A local stack keeps queries re-entrant and safe to run from multiple threads at once.
+        Stack<int> stack { };
+
+        if (m_root != null)
+        {
+            stack.push (m_root);
+        }
+
+        while (!stack.isEmpty())
+        {
+            const auto  index   = stack.pop();
+            const auto& node    = m_nodes[index];
+
+            if (node.box.intersects (box))
+            {
+                if (node.isLeaf())
+                {
+                    if (!callback (index))
+                    {
+                        return;
+                    }
+                }
+
+                else
+                {
+                    stack.push (node.child1);
+                    stack.push (node.child2);
+                }
+            }
+        }
+    }
+
+
+    template <typename Function> void AABBTree::queryPairs (const AABBTree& other, Function&& callback) const
+    {
+        if (m_root != null && other.m_root != null)
+        {
+            queryPairs (other, { m_root, other.m_root }, callback);
+        }
+    }
+
+
+    template <typename Function> void AABBTree::queryPairs (const AABBTree& other, const std::pair<int, int>& task, Function&& callback) const
+    {
+        // Traversing whole trees against each other shares work between neighbouring leaves, which is far cheaper than querying
+        // every leaf individually.
+        Stack<std::pair<int, int>>  stack       { };
+        std::pair<int, int>         children[3] { };
+
+        stack.push (task);
+
+        while (!stack.isEmpty())
+        {
+            const auto entry = stack.pop();
+            const auto count = expandPair (other, entry, children);
+
+            if (count < 0)
+            {
+                callback (entry.first, entry.second);
+            }
+
+            for (auto i = 0; i < count; ++i)
+            {
+                stack.push (children[i]);
+            }
+        }
+    }
+
+
+    inline int AABBTree::expandPair (const AABBTree& other, const std::pair<int, int>& entry, std::pair<int, int>* const children) const
+    {
+        // A node paired with itself in the same tree means its children must be tested against each other.
+        if (&other == this && entry.first == entry.second)
+        {
+            const auto& node = m_nodes[entry.first];
+
+            if (node.isLeaf())
+            {
+                return 0;
+            }
+
+            children[0] = { node.child1, node.child1 };
+            children[1] = { node.child2, node.child2 };
+            children[2] = { node.child1, node.child2 };
+            return 3;
+        }
+
+        const auto& a = m_nodes[entry.first];
+        const auto& b = other.m_nodes[entry.second];
+
+        if (!a.box.intersects (b.box))
+        {
+            return 0;
+        }
+
+        if (a.isLeaf() && b.isLeaf())
+        {
+            return -1;
+        }
+
+        // Descend into the taller node so both sides shrink at a similar rate.
+        if (b.isLeaf() || (!a.isLeaf() && a.height >= b.height))
+        {
+            children[0] = { a.child1, entry.second };
+            children[1] = { a.child2, entry.second };
+        }
+
+        else
+        {
+            children[0] = { entry.first, b.child1 };
+            children[1] = { entry.first, b.child2 };
+        }
+
+        return 2;
+    }
+
+
+    template <typename Function> void AABBTree::raycast (const Vector2<float>& from, const Vector2<float>& to, Function&& callback) const
+    {
+        // Pre-condition: The segment has a length.
+        const auto direction = to - from;
+
+        if (direction.squareMagnitude() <= 0.f)
+        {
+            return;
+        }
+
+        // The separating axis of a segment is perpendicular to it.
+        const auto  normal      = direction.normalised();
+        const auto  axis        = Vector2<float> (-normal.y, normal.x);
+        const auto  absAxis     = Vector2<float> (std::abs (axis.x), std::abs (axis.y));
+        auto        maxFraction = 1.f;
+
+        // Keep a box around the remaining segment to quickly reject nodes.
+        auto end        = from + direction * maxFraction;
+        auto segmentBox = Rectangle<float> (util::min (from.x, end.x), util::min (from.y, end.y), util::max (from.x, end.x), util::max (from.y, end.y));
+
+        Stack<int> stack { };
+
+        if (m_root != null)
+        {
+            stack.push (m_root);
+        }
+
+        while (!stack.isEmpty())
+        {
+            const auto  index   = stack.pop();
+            const auto& node    = m_nodes[index];
+
+            if (!node.box.intersects (segmentBox))
+            {
+                continue;
+            }
+
+            // Reject nodes which lie entirely on one side of the segment.
+            const auto centre       = Vector2<float> ((node.box.getLeft() + node.box.getRight()) * 0.5f, (node.box.getTop() + node.box.getBottom()) * 0.5f);
+            const auto extents      = Vector2<float> ((node.box.getRight() - node.box.getLeft()) * 0.5f, (node.box.getBottom() - node.box.getTop()) * 0.5f);
+            const auto separation   = std::abs (axis.dotProduct (from - centre)) - absAxis.dotProduct (extents);
+
+            if (separation > 0.f)
+            {
+                continue;
+            }
+
+            if (node.isLeaf())
+            {
+                const auto value = callback (index, maxFraction);
+
+                if (value == 0.f)
+                {
+                    return;
+                }
+
+                if (value > 0.f)
+                {
+                    // Clip the segment to the new fraction.
+                    maxFraction = value;
+                    end         = from + direction * maxFraction;
+                    segmentBox  = { util::min (from.x, end.x), util::min (from.y, end.y), util::max (from.x, end.x), util::max (from.y, end.y) };
+                }
+            }
+
+            else
+            {
+                stack.push (node.child1);
+                stack.push (node.child2);
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,384 @@
+#include "ColliderBuffer.hpp"
+
+
+// STL headers.
+#include <algorithm>
+#include <utility>
+
+
+// Engine headers.
+#include <Utility/Maths.hpp>
+
+
+// Intrinsic headers. SSE2 is guaranteed on x86-64 so only AVX must be enabled by the compiler.
+#if !defined WATER_DISABLE_SIMD
+    #if defined __AVX__
+        #define WATER_COLLIDER_BUFFER_AVX
+        #include <immintrin.h>
+    #elif defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+        #define WATER_COLLIDER_BUFFER_SSE
+        #include <emmintrin.h>
+    #endif
+#endif
+
+
+// Engine namespace.
+namespace water
+{
+    ////////////////////
+    /// Constructors ///
+    ////////////////////
+
+    ColliderBuffer::ColliderBuffer (ColliderBuffer&& move)
+    {
+        *this = std::move (move);
+    }
+
+
+    ColliderBuffer& ColliderBuffer::operator= (ColliderBuffer&& move)
+    {
+        if (this != &move)
+        {
+            m_left          = std::move (move.m_left);
+            m_top           = std::move (move.m_top);
+            m_right         = std::move (move.m_right);
+            m_bottom        = std::move (move.m_bottom);
+            m_layers        = std::move (move.m_layers);
+            m_triggers      = std::move (move.m_triggers);
+            m_radii         = std::move (move.m_radii);
+            m_moveX         = std::move (move.m_moveX);
+            m_moveY         = std::move (move.m_moveY);
+            m_continuous    = std::move (move.m_continuous);
+            m_sweeping      = move.m_sweeping;
+            m_circles       = move.m_circles;
+
+            // Reset primitives.
+            move.m_sweeping = 0;
+            move.m_circles  = 0;
+        }
+
+        return *this;
+    }
+
+
+    ///////////////////////////
+    /// Getters and setters ///
+    ///////////////////////////
+
+    void ColliderBuffer::setBox (const unsigned int index, const Rectangle<float>& box)
+    {
+        m_left[index]   = box.getLeft();
+        m_top[index]    = box.getTop();
+        m_right[index]  = box.getRight();
+        m_bottom[index] = box.getBottom();
+    }
+
+
+    ///////////////////////
+    /// Data management ///
+    ///////////////////////
+
+    void ColliderBuffer::clear()
+    {
+        m_left.clear();
+        m_top.clear();
+        m_right.clear();
+        m_bottom.clear();
+        m_layers.clear();
+        m_triggers.clear();
+        m_radii.clear();
+        m_moveX.clear();
+        m_moveY.clear();
+        m_continuous.clear();
+        m_sweeping = 0;
+        m_circles = 0;
+    }
+
+
+    void ColliderBuffer::reserve (const unsigned int capacity)
+    {
+        m_left.reserve (capacity);
+        m_top.reserve (capacity);
+        m_right.reserve (capacity);
+        m_bottom.reserve (capacity);
+        m_layers.reserve (capacity);
+        m_triggers.reserve (capacity);
+        m_radii.reserve (capacity);
+        m_moveX.reserve (capacity);
+        m_moveY.reserve (capacity);
+        m_continuous.reserve (capacity);
+    }
+
+
+    void ColliderBuffer::add (const Rectangle<float>& box, const unsigned int layer, const bool isTrigger, const float radius,
+                              const Vector2<float>& displacement)
+    {
+        const auto isContinuous = displacement.x != 0.f || displacement.y != 0.f;
+
+        m_left.push_back (box.getLeft());
+        m_top.push_back (box.getTop());
+        m_right.push_back (box.getRight());
+        m_bottom.push_back (box.getBottom());
+        m_layers.push_back (layer);
+        m_triggers.push_back (isTrigger ? 1 : 0);
+        m_radii.push_back (radius);
+        m_moveX.push_back (displacement.x);
+        m_moveY.push_back (displacement.y);
+        m_continuous.push_back (isContinuous ? 1 : 0);
+
+        if (isContinuous)
+        {
+            ++m_sweeping;
+        }
+
+        if (radius > 0.f)
+        {
+            ++m_circles;
+        }
+    }
+
+
+    ///////////////
+    /// Testing ///
+    ///////////////
+
+    unsigned int ColliderBuffer::intersects (const unsigned int index, const unsigned int* const candidates, const unsigned int count,
+                                             unsigned int* const results) const
+    {
+        const auto  left    = m_left[index];
+        const auto  top     = m_top[index];
+        const auto  right   = m_right[index];
+        const auto  bottom  = m_bottom[index];
+        const auto  radius  = m_radii[index];
+        const auto  rounded = m_circles != 0;
+        auto        found   = 0U;
+        auto        i       = 0U;
+
+        // Sweeping is rare enough that only the scalar path supports it, groups without a continuous collider stay vectorised. Only
+        // pairs with a continuous collider are swept, the rest of the group must still be tested exactly or circles would be treated
+        // as their boxes depending on which candidates they happened to be grouped with.
+        if (m_sweeping != 0 && (m_continuous[index] != 0 ||
+            std::any_of (candidates, candidates + count, [this] (const unsigned int other) { return m_continuous[other] != 0; })))
+        {
+            const auto  isContinuous    = m_continuous[index] != 0;
+            const auto  box             = getBox (index);
+            auto        time            = 0.f;
+
+            for (; i < count; ++i)
+            {
+                const auto other    = candidates[i];
+                const auto touches  = isContinuous || m_continuous[other] != 0 ? sweep (index, other, time) :
+                                                                                 intersects (box, radius, getBox (other), m_radii[other]);
+
+                if (touches)
+                {
+                    results[found++] = other;
+                }
+            }
+
+            return found;
+        }
+
+        // Every comparison is ordered, just like the scalar operators, so NaN values never intersect in either path.
+        #if defined WATER_COLLIDER_BUFFER_AVX
+
+            const auto left8    = _mm256_set1_ps (left);
+            const auto top8     = _mm256_set1_ps (top);
+            const auto right8   = _mm256_set1_ps (right);
+            const auto bottom8  = _mm256_set1_ps (bottom);
+            const auto radius8  = _mm256_set1_ps (radius);
+            const auto zero8    = _mm256_setzero_ps();
+
+            for (; i + 8 <= count; i += 8)
+            {
+                const auto c = candidates + i;
+
+                // The candidates are scattered so gather each edge into a register.
+                const auto otherLeft    = _mm256_set_ps (m_left[c[7]], m_left[c[6]], m_left[c[5]], m_left[c[4]],
+                                                         m_left[c[3]], m_left[c[2]], m_left[c[1]], m_left[c[0]]);
+                const auto otherTop     = _mm256_set_ps (m_top[c[7]], m_top[c[6]], m_top[c[5]], m_top[c[4]],
+                                                         m_top[c[3]], m_top[c[2]], m_top[c[1]], m_top[c[0]]);
+                const auto otherRight   = _mm256_set_ps (m_right[c[7]], m_right[c[6]], m_right[c[5]], m_right[c[4]],
+                                                         m_right[c[3]], m_right[c[2]], m_right[c[1]], m_right[c[0]]);
+                const auto otherBottom  = _mm256_set_ps (m_bottom[c[7]], m_bottom[c[6]], m_bottom[c[5]], m_bottom[c[4]],
+                                                         m_bottom[c[3]], m_bottom[c[2]], m_bottom[c[1]], m_bottom[c[0]]);
+
+                auto mask = _mm256_and_ps (_mm256_and_ps (_mm256_cmp_ps (left8, otherRight, _CMP_LE_OQ),
+                                                          _mm256_cmp_ps (top8, otherBottom, _CMP_LE_OQ)),
+                                           _mm256_and_ps (_mm256_cmp_ps (right8, otherLeft, _CMP_GE_OQ),
+                                                          _mm256_cmp_ps (bottom8, otherTop, _CMP_GE_OQ)));
+
+                // The boxes overlap so the gap between the shrunk boxes on each axis is the sum of the radii minus the overlap.
+                if (rounded)
+                {
+                    const auto otherRadius  = _mm256_set_ps (m_radii[c[7]], m_radii[c[6]], m_radii[c[5]], m_radii[c[4]],
+                                                             m_radii[c[3]], m_radii[c[2]], m_radii[c[1]], m_radii[c[0]]);
+                    const auto sum          = _mm256_add_ps (radius8, otherRadius);
+                    const auto gapX         = _mm256_max_ps (_mm256_add_ps (_mm256_max_ps (_mm256_sub_ps (left8, otherRight),
+                                                                                           _mm256_sub_ps (otherLeft, right8)), sum), zero8);
+                    const auto gapY         = _mm256_max_ps (_mm256_add_ps (_mm256_max_ps (_mm256_sub_ps (top8, otherBottom),
+                                                                                           _mm256_sub_ps (otherTop, bottom8)), sum), zero8);
+                    const auto distance     = _mm256_add_ps (_mm256_mul_ps (gapX, gapX), _mm256_mul_ps (gapY, gapY));
+
+                    mask = _mm256_and_ps (mask, _mm256_cmp_ps (distance, _mm256_mul_ps (sum, sum), _CMP_LE_OQ));
+                }
+
+                auto bits = _mm256_movemask_ps (mask);
+
+                for (auto lane = 0U; bits != 0; ++lane, bits >>= 1)
+                {
+                    if (bits & 1)
+                    {
+                        results[found++] = c[lane];
+                    }
+                }
+            }
+
+        #elif defined WATER_COLLIDER_BUFFER_SSE
+
+            const auto left4    = _mm_set1_ps (left);
+            const auto top4     = _mm_set1_ps (top);
+            const auto right4   = _mm_set1_ps (right);
+            const auto bottom4  = _mm_set1_ps (bottom);
+            const auto radius4  = _mm_set1_ps (radius);
+            const auto zero4    = _mm_setzero_ps();
+
+            for (; i + 4 <= count; i += 4)
+            {
+                const auto c = candidates + i;
+
+                // The candidates are scattered so gather each edge into a register.
+                const auto otherLeft    = _mm_set_ps (m_left[c[3]], m_left[c[2]], m_left[c[1]], m_left[c[0]]);
+                const auto otherTop     = _mm_set_ps (m_top[c[3]], m_top[c[2]], m_top[c[1]], m_top[c[0]]);
+                const auto otherRight   = _mm_set_ps (m_right[c[3]], m_right[c[2]], m_right[c[1]], m_right[c[0]]);
+                const auto otherBottom  = _mm_set_ps (m_bottom[c[3]], m_bottom[c[2]], m_bottom[c[1]], m_bottom[c[0]]);
+
+                auto mask = _mm_and_ps (_mm_and_ps (_mm_cmple_ps (left4, otherRight), _mm_cmple_ps (top4, otherBottom)),
+                                        _mm_and_ps (_mm_cmpge_ps (right4, otherLeft), _mm_cmpge_ps (bottom4, otherTop)));
+
+                // The boxes overlap so the gap between the shrunk boxes on each axis is the sum of the radii minus the overlap.
+                if (rounded)
+                {
+                    const auto otherRadius  = _mm_set_ps (m_radii[c[3]], m_radii[c[2]], m_radii[c[1]], m_radii[c[0]]);
+                    const auto sum          = _mm_add_ps (radius4, otherRadius);
+                    const auto gapX         = _mm_max_ps (_mm_add_ps (_mm_max_ps (_mm_sub_ps (left4, otherRight),
+                                                                                  _mm_sub_ps (otherLeft, right4)), sum), zero4);
+                    const auto gapY         = _mm_max_ps (_mm_add_ps (_mm_max_ps (_mm_sub_ps (top4, otherBottom),
+                                                                                  _mm_sub_ps (otherTop, bottom4)), sum), zero4);
+                    const auto distance     = _mm_add_ps (_mm_mul_ps (gapX, gapX), _mm_mul_ps (gapY, gapY));
+
+                    mask = _mm_and_ps (mask, _mm_cmple_ps (distance, _mm_mul_ps (sum, sum)));
+                }
+
+                auto bits = _mm_movemask_ps (mask);
+
+                for (auto lane = 0U; bits != 0; ++lane, bits >>= 1)
+                {
+                    if (bits & 1)
+                    {
+                        results[found++] = c[lane];
+                    }
+                }
+            }
+
+        #endif
+
+        // Test whatever remains one at a time, without circles this matches Rectangle::intersects().
+        for (; i < count; ++i)
+        {
+            const auto other = candidates[i];
+
+            if (rounded ? intersects ({ left, top, right, bottom }, radius, getBox (other), m_radii[other]) :
+                          left <= m_right[other] && top <= m_bottom[other] && right >= m_left[other] && bottom >= m_top[other])
+            {
+                results[found++] = other;
+            }
+        }
+
+        return found;
+    }
+
+
+    bool ColliderBuffer::intersects (const unsigned int index, const Rectangle<float>& box) const
+    {
+        return intersects (getBox (index), m_radii[index], box, 0.f);
+    }
+
+
+    bool ColliderBuffer::sweep (const unsigned int a, const unsigned int b, float& time) const
+    {
+        return sweep (getBox (a), getDisplacement (a), getBox (b), getDisplacement (b), time);
+    }
+
+
+    bool ColliderBuffer::sweep (const unsigned int index, const Rectangle<float>& box, float& time) const
+    {
+        return sweep (getBox (index), getDisplacement (index), box, { 0.f, 0.f }, time);
+    }
+
+
+    /////////////////////////
+    /// Internal workings ///
+    /////////////////////////
+
+    bool ColliderBuffer::intersects (const Rectangle<float>& a, const float radiusA, const Rectangle<float>& b, const float radiusB)
+    {
+        // Pre-condition: The boxes overlap, this also rejects NaN values.
+        if (!a.intersects (b))
+        {
+            return false;
+        }
+
+        const auto sum  = radiusA + radiusB;
+        const auto gapX = util::max (util::max (a.getLeft() - b.getRight(), b.getLeft() - a.getRight()) + sum, 0.f);
+        const auto gapY = util::max (util::max (a.getTop() - b.getBottom(), b.getTop() - a.getBottom()) + sum, 0.f);
+
+        return gapX * gapX + gapY * gapY <= sum * sum;
+    }
+
+
+    bool ColliderBuffer::sweep (const Rectangle<float>& a, const Vector2<float>& moveA, const Rectangle<float>& b,
+                                const Vector2<float>& moveB, float& time)
+    {
+        // Work in the frame of b so only a moves. Each axis gives the range of the update during which the boxes overlap on it.
+        auto entry  = 0.f;
+        auto exit   = 1.f;
+
+        const auto slab = [&] (const float lowA, const float highA, const float lowB, const float highB,
+                               const float moveA, const float moveB)
+        {
+            const auto motion       = moveA - moveB;
+            const auto startLow     = lowA - moveA + moveB;
+            const auto startHigh    = highA - moveA + moveB;
+
+            // Without relative motion the boxes must overlap for the whole update.
+            if (motion == 0.f)
+            {
+                return startLow <= highB && startHigh >= lowB;
+            }
+
+            const auto inverse  = 1.f / motion;
+            auto near           = (lowB - startHigh) * inverse;
+            auto far            = (highB - startLow) * inverse;
+
+            if (near > far)
+            {
+                std::swap (near, far);
+            }
+
+            entry   = util::max (entry, near);
+            exit    = util::min (exit, far);
+
+            return entry <= exit;
+        };
+
+        if (slab (a.getLeft(), a.getRight(), b.getLeft(), b.getRight(), moveA.x, moveB.x) &&
+            slab (a.getTop(), a.getBottom(), b.getTop(), b.getBottom(), moveA.y, moveB.y))
+        {
+            time = entry;
+            return true;
+        }
+
+        return false;
+    }
+}
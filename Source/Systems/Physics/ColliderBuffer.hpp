@@ -0,0 +1,171 @@
+#if !defined WATER_COLLIDER_BUFFER_INCLUDED
+#define WATER_COLLIDER_BUFFER_INCLUDED
+
+
+// STL headers.
+#include <cstdint>
+#include <vector>
+
+
+// Engine headers.
+#include <Misc/Rectangle.hpp>
+#include <Misc/Vector2.hpp>
+
+
+// Engine namespace.
+namespace water
+{
+    /// <summary>
+    /// Contiguous structure-of-arrays storage for the world-space box, layer and trigger flag of every collider in a physics update.
+    /// Keeping each component in its own array means overlap tests touch only the memory they need and can be vectorised. Boxes can
+    /// be tested four or eight at a time using SSE or AVX when available, define WATER_DISABLE_SIMD to force the scalar path. Continuous
+    /// colliders also store how far they moved during the update so they can be swept against the others, preventing tunnelling.
+    /// Circles are stored as the box they fit inside along with their radius. Every collider is then a box shrunk by its radius and
+    /// rounded out again, which lets box-box, circle-box and circle-circle pairs share a single branchless test.
+    /// </summary>
+    class ColliderBuffer final
+    {
+        public:
+
+            ///////////////////////////////////
+            /// Constructors and destructor ///
+            ///////////////////////////////////
+
+            ColliderBuffer()                                        = default;
+            ColliderBuffer (const ColliderBuffer& copy)             = default;
+            ColliderBuffer& operator= (const ColliderBuffer& copy)  = default;
+            ~ColliderBuffer()                                       = default;
+
+            ColliderBuffer (ColliderBuffer&& move);
+            ColliderBuffer& operator= (ColliderBuffer&& move);
+
+
+            ///////////////////////////
+            /// Getters and setters ///
+            ///////////////////////////
+
+            /// <summary> Obtains the number of colliders in the buffer. </summary>
+            unsigned int size() const                                       { return (unsigned int) m_layers.size(); }
+
+            /// <summary> Reconstructs the world-space box of a collider. </summary>
+            Rectangle<float> getBox (const unsigned int index) const        { return { m_left[index], m_top[index], m_right[index], m_bottom[index] }; }
+
+            /// <summary> Obtains the layer of a collider. </summary>
+            unsigned int getLayer (const unsigned int index) const          { return m_layers[index]; }
+
+            /// <summary> Indicates whether a collider is a trigger. </summary>
+            bool isTrigger (const unsigned int index) const                 { return m_triggers[index] != 0; }
+
+            /// <summary> Obtains the radius of a circular collider, zero for boxes. </summary>
+            float getRadius (const unsigned int index) const                { return m_radii[index]; }
+
+            /// <summary> Indicates whether a collider is a circle. </summary>
+            bool isCircle (const unsigned int index) const                  { return m_radii[index] > 0.f; }
+
+            /// <summary> Indicates whether a collider moved continuously during the update and must be swept. </summary>
+            bool isContinuous (const unsigned int index) const              { return m_continuous[index] != 0; }
+
+            /// <summary> Obtains how far a collider moved to reach its current box, zero for discrete colliders. </summary>
+            Vector2<float> getDisplacement (const unsigned int index) const { return { m_moveX[index], m_moveY[index] }; }
+
+            /// <summary> Replaces the world-space box of a collider, used when an object is moved after its collider was added. </summary>
+            void setBox (const unsigned int index, const Rectangle<float>& box);
+
+
+            ///////////////////////
+            /// Data management ///
+            ///////////////////////
+
+            /// <summary> Removes every collider, reserved memory is maintained. </summary>
+            void clear();
+
+            /// <summary> Reserves enough memory for the given number of colliders. </summary>
+            void reserve (const unsigned int capacity);
+
+            /// <summary> Adds a collider to the end of the buffer, its index will be the previous size of the buffer. </summary>
+            /// <param name="box"> The world-space box of the collider. </param>
+            /// <param name="layer"> The layer of the collider. </param>
+            /// <param name="isTrigger"> Whether the collider is a trigger. </param>
+            /// <param name="radius"> The radius of a circular collider, the box must fit the circle exactly. Zero for boxes. </param>
+            /// <param name="displacement"> How far the box moved to reach its current position, zero for discrete colliders. </param>
+            void add (const Rectangle<float>& box, const unsigned int layer, const bool isTrigger, const float radius,
+                      const Vector2<float>& displacement = { 0.f, 0.f });
+
+
+            ///////////////
+            /// Testing ///
+            ///////////////
+
+            /// <summary>
+            /// Tests one collider against many others, boxes give the same results as Rectangle::intersects(). If either collider of
+            /// a pair is continuous the boxes of the pair are swept instead, so it also intersects if they touched mid-update. Pairs
+            /// without a continuous collider are always tested exactly, whatever they're grouped with.
+            /// </summary>
+            /// <param name="index"> The collider to test. </param>
+            /// <param name="candidates"> The indices of the colliders to test against. </param>
+            /// <param name="count"> How many candidates there are. </param>
+            /// <param name="results"> Filled with each candidate which intersects, in the same order. Must hold count elements. </param>
+            /// <returns> How many candidates intersect. </returns>
+            unsigned int intersects (const unsigned int index, const unsigned int* const candidates, const unsigned int count,
+                                     unsigned int* const results) const;
+
+            /// <summary> Tests a collider against a box which isn't in the buffer, such as a tile or a query region. </summary>
+            /// <param name="index"> The collider to test. </param>
+            /// <param name="box"> The world-space box to test against. </param>
+            /// <returns> Whether the collider touches the box, circles must reach the box rather than just their bounds. </returns>
+            bool intersects (const unsigned int index, const Rectangle<float>& box) const;
+
+            /// <summary>
+            /// Sweeps two colliders from where they were at the start of the update to where they are now, finding the time of impact
+            /// using the slab method on their relative motion. Without any relative motion this is the same as Rectangle::intersects().
+            /// </summary>
+            /// <param name="a"> The first collider. </param>
+            /// <param name="b"> The second collider. </param>
+            /// <param name="time"> Set to the fraction of the update at which the boxes first touch, zero if they started overlapping. </param>
+            /// <returns> Whether the boxes touched at any point during the update. </returns>
+            bool sweep (const unsigned int a, const unsigned int b, float& time) const;
+
+            /// <summary> Sweeps a collider against a box which didn't move during the update, such as a tile. </summary>
+            /// <param name="index"> The collider to sweep. </param>
+            /// <param name="box"> The world-space box to sweep against. </param>
+            /// <param name="time"> Set to the fraction of the update at which the boxes first touch, zero if they started overlapping. </param>
+            /// <returns> Whether the boxes touched at any point during the update. </returns>
+            bool sweep (const unsigned int index, const Rectangle<float>& box, float& time) const;
+
+        private:
+
+            /////////////////////////
+            /// Internal workings ///
+            /////////////////////////
+
+            /// <summary>
+            /// Tests two boxes which have each been shrunk by a radius then rounded out again, the gap between the shrunk boxes must be
+            /// no longer than the sum of the radii. Boxes without a radius are tested exactly as Rectangle::intersects().
+            /// </summary>
+            static bool intersects (const Rectangle<float>& a, const float radiusA, const Rectangle<float>& b, const float radiusB);
+
+            /// <summary> Sweeps two boxes which each moved by the given amount to reach where they are now. </summary>
+            static bool sweep (const Rectangle<float>& a, const Vector2<float>& moveA, const Rectangle<float>& b,
+                               const Vector2<float>& moveB, float& time);
+
+
+            ///////////////////////////
+            /// Implementation data ///
+            ///////////////////////////
+
+            std::vector<float>          m_left          { };    //!< The left edge of each box.
+            std::vector<float>          m_top           { };    //!< The top edge of each box.
+            std::vector<float>          m_right         { };    //!< The right edge of each box.
+            std::vector<float>          m_bottom        { };    //!< The bottom edge of each box.
+            std::vector<unsigned int>   m_layers        { };    //!< The layer of each collider.
+            std::vector<std::uint8_t>   m_triggers      { };    //!< Whether each collider is a trigger, bytes avoid the std::vector<bool> specialisation.
+            std::vector<float>          m_radii         { };    //!< The radius of each circle, zero for boxes.
+            std::vector<float>          m_moveX         { };    //!< How far each box moved horizontally during the update.
+            std::vector<float>          m_moveY         { };    //!< How far each box moved vertically during the update.
+            std::vector<std::uint8_t>   m_continuous    { };    //!< Whether each collider moved and must be swept.
+            unsigned int                m_sweeping      { 0 };  //!< The number of continuous colliders, the vectorised tests are used when zero.
+            unsigned int                m_circles       { 0 };  //!< The number of circles, boxes only need their edges compared when zero.
+    };
+}
+
+#endif
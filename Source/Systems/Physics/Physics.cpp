@@ -1,13 +1,272 @@
 #include "Physics.hpp"
 
 
+// STL headers.
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+
 // Engine namespace.
 #include <GameComponents/PhysicsObject.hpp>
+#include <Utility/Profiler.hpp>
 
 
 // Engine namespace.
 namespace water
 {
+    /// <summary> The clock used to measure each stage of a physics update. </summary>
+    using Clock = std::chrono::steady_clock;
+
+
+    /// <summary> Measures the time since the given mark then moves the mark to now, so consecutive stages can be timed in turn. </summary>
+    /// <returns> The time elapsed in seconds. </returns>
+    static float lap (Clock::time_point& mark)
+    {
+        const auto now      = Clock::now();
+        const auto elapsed  = std::chrono::duration<float> (now - mark).count();
+        mark                = now;
+
+        return elapsed;
+    }
+
+
+    /// <summary> Finds where a ray enters a box using the slab method. </summary>
+    /// <param name="origin"> The start point of the ray. </param>
+    /// <param name="delta"> The direction and length of the ray. </param>
+    /// <param name="box"> The box to test against. </param>
+    /// <param name="maxFraction"> The maximum fraction of the ray which may be travelled. </param>
+    /// <param name="fraction"> Set to the fraction of the ray travelled before entering the box. </param>
+    /// <param name="normal"> Set to the normal of the side which was entered, zero if the ray starts inside the box. </param>
+    /// <returns> Whether the ray enters the box before reaching the maximum fraction. </returns>
+    static bool intersectRay (const Vector2<float>& origin, const Vector2<float>& delta, const Rectangle<float>& box,
+                              const float maxFraction, float& fraction, Vector2<float>& normal)
+    {
+        auto entry  = 0.f;
+        auto exit   = maxFraction;
+        normal      = { 0.f, 0.f };
+
+        // Test a single axis, narrowing the range of the ray which is inside the box.
+        const auto slab = [&] (const float start, const float length, const float low, const float high, const Vector2<float>& axis)
+        {
+            // A ray parallel to the slab must start within it.
+            if (std::abs (length) < 1e-8f)
+            {
+                return start >= low && start <= high;
+            }
+
+            const auto inverse  = 1.f / length;
+            auto near           = (low - start) * inverse;
+            auto far            = (high - start) * inverse;
+            auto side           = -1.f;
+
+            if (near > far)
+            {
+                std::swap (near, far);
+                side = 1.f;
+            }
+
+            if (near > entry)
+            {
+                entry   = near;
+                normal  = axis * side;
+            }
+
+            exit = util::min (exit, far);
+
+            return entry <= exit;
+        };
+
+        if (slab (origin.x, delta.x, box.getLeft(), box.getRight(), { 1.f, 0.f }) &&
+            slab (origin.y, delta.y, box.getTop(), box.getBottom(), { 0.f, 1.f }))
+        {
+            fraction = entry;
+            return true;
+        }
+
+        return false;
+    }
+
+
+    /// <summary> Finds where a ray enters a circle by solving for the distance along the ray at which it reaches the radius. </summary>
+    /// <param name="origin"> The start point of the ray. </param>
+    /// <param name="delta"> The direction and length of the ray. </param>
+    /// <param name="centre"> The centre of the circle. </param>
+    /// <param name="radius"> The radius of the circle. </param>
+    /// <param name="maxFraction"> The maximum fraction of the ray which may be travelled. </param>
+    /// <param name="fraction"> Set to the fraction of the ray travelled before entering the circle. </param>
+    /// <param name="normal"> Set to the normal of the circle where the ray entered, zero if the ray starts inside the circle. </param>
+    /// <returns> Whether the ray enters the circle before reaching the maximum fraction. </returns>
+    static bool intersectCircle (const Vector2<float>& origin, const Vector2<float>& delta, const Vector2<float>& centre, const float radius,
+                                 const float maxFraction, float& fraction, Vector2<float>& normal)
+    {
+        const auto offset   = origin - centre;
+        const auto inside   = offset.squareMagnitude() - radius * radius;
+
+        if (inside <= 0.f)
+        {
+            fraction    = 0.f;
+            normal      = { 0.f, 0.f };
+            return true;
+        }
+
+        // Solve |offset + delta * t| = radius, the ray must be heading towards the centre to enter.
+        const auto a        = delta.squareMagnitude();
+        const auto b        = offset.x * delta.x + offset.y * delta.y;
+        const auto square   = b * b - a * inside;
+
+        if (a <= 0.f || b >= 0.f || square < 0.f)
+        {
+            return false;
+        }
+
+        const auto entry = (-b - std::sqrt (square)) / a;
+
+        if (entry > maxFraction)
+        {
+            return false;
+        }
+
+        fraction    = entry;
+        normal      = (offset + delta * entry) / radius;
+        return true;
+    }
+
+
+    /// <summary> Finds where a ray enters the solid tiles of a tilemap, testing the merged runs of tiles rather than every tile. </summary>
+    /// <param name="tilemap"> The tilemap to test against. </param>
+    /// <param name="bounds"> The world-space bounds of the tilemap, the tiles are relative to its top-left corner. </param>
+    /// <param name="origin"> The start point of the ray. </param>
+    /// <param name="delta"> The direction and length of the ray. </param>
+    /// <param name="maxFraction"> The maximum fraction of the ray which may be travelled. </param>
+    /// <param name="fraction"> Set to the fraction of the ray travelled before entering the closest run. </param>
+    /// <param name="normal"> Set to the normal of the side which was entered, zero if the ray starts inside a run. </param>
+    /// <returns> Whether the ray enters a run before reaching the maximum fraction. </returns>
+    static bool intersectTiles (const TilemapCollider& tilemap, const Rectangle<float>& bounds, const Vector2<float>& origin,
+                                const Vector2<float>& delta, const float maxFraction, float& fraction, Vector2<float>& normal)
+    {
+        const auto  from    = Vector2<float> { origin.x - bounds.getLeft(), origin.y - bounds.getTop() };
+        auto        found   = false;
+
+        // The tilemap clips the shortened segment so its fractions are scaled back to fractions of the whole ray.
+        tilemap.raycast (from, from + delta * maxFraction, [&] (const TileRun& run, const float clip)
+        {
+            auto entry      = 0.f;
+            auto surface    = Vector2<float> { };
+
+            if (!intersectRay (from, delta, run.box, clip * maxFraction, entry, surface))
+            {
+                return -1.f;
+            }
+
+            fraction    = entry;
+            normal      = surface;
+            found       = true;
+
+            return entry / maxFraction;
+        });
+
+        return found;
+    }
+
+
+    /// <summary> Measures how far two boxes overlap on each axis. </summary>
+    /// <returns> The overlap on each axis, an axis is negative if the boxes are separated on it. </returns>
+    static Vector2<float> overlap (const Rectangle<float>& a, const Rectangle<float>& b)
+    {
+        return { util::min (a.getRight(), b.getRight()) - util::max (a.getLeft(), b.getLeft()),
+                 util::min (a.getBottom(), b.getBottom()) - util::max (a.getTop(), b.getTop()) };
+    }
+
+
+    /// <summary> Finds the smallest movement along an axis which takes one range out of another. </summary>
+    /// <param name="low"> The lower edge of the range being moved. </param>
+    /// <param name="high"> The upper edge of the range being moved. </param>
+    /// <param name="otherLow"> The lower edge of the range to move out of. </param>
+    /// <param name="otherHigh"> The upper edge of the range to move out of. </param>
+    /// <param name="motion"> If non-zero the range is moved against this direction, regardless of which side is closer. </param>
+    /// <returns> The movement required, negative values move towards the lower edge. </returns>
+    static float exit (const float low, const float high, const float otherLow, const float otherHigh, const float motion)
+    {
+        const auto lower    = otherLow - high;
+        const auto higher   = otherHigh - low;
+
+        if (motion != 0.f)
+        {
+            return motion > 0.f ? lower : higher;
+        }
+
+        return -lower < higher ? lower : higher;
+    }
+
+
+    /// <summary> Calls the desired event on two objects, respecting whether either of them is a trigger. </summary>
+    /// <param name="event"> The event to call. </param>
+    /// <param name="first"> The object with the lower index, nullptr if it no longer exists. </param>
+    /// <param name="firstTrigger"> Whether the first object is a trigger. </param>
+    /// <param name="second"> The object with the higher index, nullptr if it no longer exists. </param>
+    /// <param name="secondTrigger"> Whether the second object is a trigger. </param>
+    /// <param name="stats"> Has its callback counts incremented for each function called. </param>
+    static void dispatch (const ContactEvent event, PhysicsObject* const first, const bool firstTrigger,
+                          PhysicsObject* const second, const bool secondTrigger, PhysicsStats& stats)
+    {
+        // Objects which no longer exist can't be notified.
+        const auto trigger = [event, &stats] (PhysicsObject* const object, PhysicsObject* const other)
+        {
+            if (object)
+            {
+                ++stats.triggerCallbacks;
+
+                switch (event)
+                {
+                    case ContactEvent::Enter:   object->onTriggerEnter (other);  break;
+                    case ContactEvent::Stay:    object->onTriggerStay (other);   break;
+                    case ContactEvent::Exit:    object->onTriggerExit (other);   break;
+                }
+            }
+        };
+
+        const auto collide = [event, &stats] (PhysicsObject* const object, PhysicsObject* const other)
+        {
+            if (object)
+            {
+                ++stats.collisionCallbacks;
+
+                switch (event)
+                {
+                    case ContactEvent::Enter:   object->onCollisionEnter (other);    break;
+                    case ContactEvent::Stay:    object->onCollisionStay (other);     break;
+                    case ContactEvent::Exit:    object->onCollisionExit (other);     break;
+                }
+            }
+        };
+
+        // Determine the desired collision type.
+        if (firstTrigger)
+        {
+            trigger (first, second);
+
+            if (secondTrigger)
+            {
+                trigger (second, first);
+            }
+        }
+
+        // Collider on trigger.
+        else if (secondTrigger)
+        {
+            trigger (second, first);
+        }
+
+        // Collider on collider.
+        else
+        {
+            collide (first, second);
+            collide (second, first);
+        }
+    }
+
+
     ////////////////////
     /// Constructors ///
     ////////////////////
@@ -22,7 +281,55 @@ namespace water
     {
         if (this != &move)
         {
-            m_layers = std::move (move.m_layers);
+            m_layers         = std::move (move.m_layers);
+            m_partitions     = std::move (move.m_partitions);
+            m_colliders      = std::move (move.m_colliders);
+            m_jobs           = move.m_jobs;
+            m_tasks          = std::move (move.m_tasks);
+            m_split          = std::move (move.m_split);
+            m_candidates     = std::move (move.m_candidates);
+            m_offsets        = std::move (move.m_offsets);
+            m_grouped        = std::move (move.m_grouped);
+            m_hits           = std::move (move.m_hits);
+            m_batches        = std::move (move.m_batches);
+            m_pairs          = std::move (move.m_pairs);
+            m_contacts       = std::move (move.m_contacts);
+            m_exits          = std::move (move.m_exits);
+            m_handlers       = std::move (move.m_handlers);
+            m_routes         = std::move (move.m_routes);
+            m_resolve        = std::move (move.m_resolve);
+            m_transfers      = std::move (move.m_transfers);
+            m_islands        = std::move (move.m_islands);
+            m_islandSteps    = std::move (move.m_islandSteps);
+            m_movers         = std::move (move.m_movers);
+            m_tilemaps       = std::move (move.m_tilemaps);
+            m_tileLayers     = std::move (move.m_tileLayers);
+            m_obstacles      = std::move (move.m_obstacles);
+            m_projectiles    = std::move (move.m_projectiles);
+            m_projectileHits = std::move (move.m_projectileHits);
+            m_hitBatches     = std::move (move.m_hitBatches);
+            m_sweepTests     = std::move (move.m_sweepTests);
+            m_sweeps         = std::move (move.m_sweeps);
+            m_targets        = std::move (move.m_targets);
+            m_hitHandler     = std::move (move.m_hitHandler);
+            m_stats          = move.m_stats;
+            m_history        = std::move (move.m_history);
+            m_stayEvents     = move.m_stayEvents;
+            m_integration    = move.m_integration;
+            m_resolution     = move.m_resolution;
+            m_sleepSteps     = move.m_sleepSteps;
+            m_sleepTolerance = move.m_sleepTolerance;
+            m_awake          = move.m_awake;
+            m_stamp          = move.m_stamp;
+
+            // Reset primitives.
+            move.m_stayEvents       = true;
+            move.m_integration      = false;
+            move.m_resolution       = false;
+            move.m_sleepSteps       = 0;
+            move.m_sleepTolerance   = 0.f;
+            move.m_awake            = 0;
+            move.m_stamp            = 0;
         }
 
         return *this;
@@ -33,69 +340,156 @@ namespace water
     /// System management ///
     /////////////////////////
 
-    void Physics::initialise()
+    void Physics::initialise (const float margin, util::JobSystem* const jobs)
     {
-        // Nothing to do but resize the layermask collection.
-        m_layers.resize (32);
+        // Pre-condition: The margin is usable.
+        if (margin < 0.f)
+        {
+            throw std::invalid_argument ("Physics::initialise(), margin must not be negative.");
+        }
+
+        // Every layer collides with every layer by default.
+        m_layers.assign (32, ~0U);
+
+        // Each layer has a dynamic and a static partition, tilemaps are kept in a partition of their own after them. Statics don't
+        // move often enough to benefit from a margin.
+        m_partitions.resize (getTilemapPartition() + 1);
+
+        for (auto layer = 0U; layer < 32; ++layer)
+        {
+            m_partitions[getPartition (layer, false)].tree.setMargin (margin);
+            m_partitions[getPartition (layer, true)].tree.setMargin (0.f);
+        }
+
+        m_partitions[getTilemapPartition()].tree.setMargin (0.f);
+        m_tileLayers.assign (32, ~0U);
+
+        // Each thread needs its own buffers so they never have to synchronise.
+        m_jobs = jobs;
+        m_candidates.resize (getThreadCount());
+        m_hits.resize (getThreadCount());
+        m_sweeps.resize (getThreadCount());
+        m_targets.resize (32);
     }
 
 
-    void Physics::detectCollisions (const std::vector<PhysicsObject*>& objects)
+    void Physics::detectCollisions (const std::vector<PhysicsObject*>& objects, const float delta)
     {
-        // Lets go through each collidable object checking if they collide.
-        for (auto i = 0U; i < objects.size(); ++i)
+        WATER_PROFILE_ZONE ("Detect collisions");
+
+        // Each stage adds to the measurements as it goes, findPairs() splits its own time between the broadphase and narrowphase.
+        const auto  start   = Clock::now();
+        auto        mark    = start;
+
+        m_stats         = PhysicsStats { };
+        m_stats.objects = (unsigned int) objects.size();
+
+        // Move objects before the trees are refitted so the proxies are up-to-date.
+        if (m_integration)
         {
-            // Cache the values for the first object.
-            auto        first        = objects[i];
-            const auto& check        = first->getCollider();
-            const auto  checkLayer   = m_layers[check.getLayer()];
+            integrate (objects, delta);
+        }
 
-            auto checkBox           = check.getBox();
-            checkBox.translate (first->getPosition().x, first->getPosition().y);
+        m_stats.solverTime += lap (mark);
 
-            for (auto j = i + 1; j < objects.size(); ++j)
-            {
-                // Cache the values for the second object.
-                auto        second  = objects[j];
-                const auto& against = second->getCollider();
+        // Refit the trees and let them tell us which objects overlap.
+        updateProxies (objects, delta);
+        refreshContacts();
 
-                // Check if their layers collide.
-                if ((checkLayer | (1 << against.getLayer())) > 0)
-                {
-                    // We must now check if the rectangles intersect.
-                    auto againstBox = against.getBox();
-                    againstBox.translate (second->getPosition().x, second->getPosition().y);
+        m_stats.broadphaseTime += lap (mark);
+        findPairs();
+        mark = Clock::now();
 
-                    // Check if they intersect.
-                    if (checkBox.intersects (againstBox))
-                    {
-                        // Determine the desired collision type.
-                        if (check.isTrigger())
-                        {
-                            first->onTrigger (second);
+        // Objects should be where they'll stay before any events are called.
+        if (m_resolution)
+        {
+            resolvePenetrations (objects, delta);
+        }
 
-                            if (against.isTrigger())
-                            {
-                                second->onTrigger (first);
-                            }
-                        }
+        if (m_sleepSteps != 0)
+        {
+            updateSleep (objects);
+        }
 
-                        // Collider on trigger.
-                        else if (against.isTrigger())
-                        {
-                            second->onTrigger (first);
-                        }
+        m_stats.solverTime += lap (mark);
 
-                        // Collider on collider.
-                        else
-                        {
-                            first->onCollision (second);
-                            second->onCollision (first);
-                        }
-                    }
-                }
+        // Only pairs on colliding layers are ever found.
+        for (const auto& pair : m_pairs)
+        {
+            updateContact (objects, pair);
+        }
+
+        callHandlers (ContactEvent::Enter);
+        callHandlers (ContactEvent::Stay);
+
+        // Anything left over has stopped touching.
+        removeStaleContacts();
+
+        m_stats.dispatchTime += lap (mark);
+
+        // Projectiles are swept against objects where they'll be seen by the game.
+        updateProjectiles (delta);
+
+        m_stats.projectileTime += lap (mark);
+        m_stats.totalTime = std::chrono::duration<float> (mark - start).count();
+
+        // The projectiles have already added their own tests.
+        m_stats.awake               = m_awake;
+        m_stats.candidatePairs      = (unsigned int) m_grouped.size();
+        m_stats.narrowphaseTests   += (unsigned int) m_grouped.size();
+        m_stats.overlaps            = (unsigned int) m_pairs.size();
+
+        m_history.push (m_stats);
+    }
+
+
+    void Physics::simulate (const std::vector<PhysicsObject*>& objects, const float delta, const unsigned int steps,
+                            const std::function<void()>& beforeStep)
+    {
+        for (auto step = 0U; step < steps; ++step)
+        {
+            if (beforeStep)
+            {
+                beforeStep();
             }
+
+            detectCollisions (objects, delta);
+        }
+    }
+
+
+    ///////////////////
+    /// Diagnostics ///
+    ///////////////////
+
+    const PhysicsStats& Physics::getStatsHistory (const unsigned int index) const
+    {
+        // The ring wraps indices around so an invalid index would silently read the wrong update, or divide by zero when empty.
+        if (index >= m_history.size())
+        {
+            throw std::out_of_range ("Physics::getStatsHistory(), index " + std::to_string (index) + " is beyond the " +
+                                     std::to_string (m_history.size()) + " updates kept.");
+        }
+
+        return m_history[index];
+    }
+
+
+    //////////////////
+    /// Simulation ///
+    //////////////////
+
+    void Physics::setSleeping (const unsigned int steps, const float tolerance)
+    {
+        // Pre-condition: The tolerance is usable.
+        if (tolerance < 0.f)
+        {
+            throw std::invalid_argument ("Physics::setSleeping(), tolerance must not be negative.");
         }
+
+        // Sleeping objects are woken during the next update if sleeping has been disabled.
+        m_sleepSteps        = steps;
+        m_sleepTolerance    = tolerance;
     }
 
 
@@ -118,7 +512,7 @@ namespace water
         // Pre-condition: Both layers are valid.
         if (layerToModify < 32 && layerToAdd < 32)
         {
-            m_layers[layerToModify] |= 1 << layerToAdd;
+            m_layers[layerToModify] |= 1U << layerToAdd;
         }
     }
 
@@ -128,7 +522,1310 @@ namespace water
         // Pre-condition: Both layers are valid.
         if (layerToModify < 32 && layerToRemove < 32)
         {
-            m_layers[layerToModify] &= ~(1 << layerToRemove);
+            m_layers[layerToModify] &= ~(1U << layerToRemove);
+        }
+    }
+
+
+    //////////////
+    /// Events ///
+    //////////////
+
+    void Physics::setContactHandler (const unsigned int layerA, const unsigned int layerB, const ContactHandler& handler)
+    {
+        // Pre-condition: Both layers are valid.
+        if (layerA >= 32 || layerB >= 32)
+        {
+            return;
+        }
+
+        if (m_routes.empty())
+        {
+            m_routes.assign (32 * 32, ~0U);
+        }
+
+        auto index = m_routes[layerA * 32 + layerB];
+
+        // Removing a handler leaves it empty so it can be reused by the next registration.
+        if (!handler)
+        {
+            if (index != ~0U)
+            {
+                m_handlers[index] = Handler { };
+                m_routes[layerA * 32 + layerB] = ~0U;
+                m_routes[layerB * 32 + layerA] = ~0U;
+            }
+
+            return;
+        }
+
+        if (index == ~0U)
+        {
+            const auto unused = std::find_if (m_handlers.begin(), m_handlers.end(), [] (const Handler& existing)
+            {
+                return !existing.function;
+            });
+
+            index = (unsigned int) (unused - m_handlers.begin());
+
+            if (unused == m_handlers.end())
+            {
+                m_handlers.emplace_back();
+            }
+        }
+
+        m_handlers[index].function  = handler;
+        m_handlers[index].layer     = layerA;
+        m_routes[layerA * 32 + layerB] = index;
+        m_routes[layerB * 32 + layerA] = index;
+    }
+
+
+    ///////////////
+    /// Queries ///
+    ///////////////
+
+    void Physics::queryRegion (const Rectangle<float>& region, std::vector<PhysicsObject*>& results) const
+    {
+        results.clear();
+
+        for (const auto& partition : m_partitions)
+        {
+            // The tree may store fattened boxes so each proxy found must be checked against its tight box.
+            partition.tree.query (region, [&] (const int proxy)
+            {
+                const auto& data    = partition.proxies[proxy];
+                const auto  box     = m_colliders.getBox (data.index);
+
+                // Tilemaps are only found if the region touches a solid tile, the tiles are relative to the top-left of the bounds.
+                auto local = region;
+                local.translate (-box.getLeft(), -box.getTop());
+
+                if (data.tilemap ? data.tilemap->overlaps (local, ~0U) : m_colliders.intersects (data.index, region))
+                {
+                    results.push_back (data.object);
+                }
+
+                return true;
+            });
+        }
+    }
+
+
+    void Physics::queryRegions (const Rectangle<float>* const regions, const unsigned int* const layers, const unsigned int count,
+                                std::vector<RegionOverlap>& results) const
+    {
+        results.clear();
+
+        for (auto i = 0U; i < count; ++i)
+        {
+            const auto& region  = regions[i];
+            const auto  layer   = layers[i];
+
+            if (layer >= 32)
+            {
+                continue;
+            }
+
+            for (auto index = 0U; index < m_partitions.size(); ++index)
+            {
+                // Whole partitions are skipped when their layer doesn't collide, tilemaps only consider the tiles on colliding layers.
+                const auto& partition   = m_partitions[index];
+                const auto  isTilemap   = index == getTilemapPartition();
+
+                if (partition.count == 0 || (isTilemap ? m_tileLayers[layer] == 0 : !collides (layer, index / 2)))
+                {
+                    continue;
+                }
+
+                partition.tree.query (region, [&] (const int proxy)
+                {
+                    const auto& data    = partition.proxies[proxy];
+                    const auto  box     = m_colliders.getBox (data.index);
+
+                    auto local = region;
+                    local.translate (-box.getLeft(), -box.getTop());
+
+                    if (data.tilemap ? data.tilemap->overlaps (local, m_tileLayers[layer]) : m_colliders.intersects (data.index, region))
+                    {
+                        results.push_back ({ i, data.object });
+                    }
+
+                    return true;
+                });
+            }
+        }
+    }
+
+
+    void Physics::queryPoint (const Vector2<float>& point, std::vector<PhysicsObject*>& results) const
+    {
+        // A point is just a region with no area.
+        queryRegion ({ point.x, point.y, point.x, point.y }, results);
+    }
+
+
+    bool Physics::raycast (const Vector2<float>& origin, const Vector2<float>& direction, const float distance, RaycastHit& hit) const
+    {
+        hit = RaycastHit();
+
+        // Pre-condition: The ray actually goes somewhere.
+        if (distance <= 0.f || direction.squareMagnitude() <= 0.f)
+        {
+            return false;
+        }
+
+        // Each partition only needs to consider objects closer than the hits found in previous partitions.
+        const auto  normal  = direction.normalised();
+        auto        found   = false;
+
+        for (const auto& partition : m_partitions)
+        {
+            if (raycast (partition, origin, normal, found ? hit.distance : distance, hit))
+            {
+                found = true;
+            }
+        }
+
+        return found;
+    }
+
+
+    /////////////////////////
+    /// Internal workings ///
+    /////////////////////////
+
+    void Physics::updateProxies (const std::vector<PhysicsObject*>& objects, const float delta)
+    {
+        // A new stamp allows us to find the proxies of objects which have been removed since the last update.
+        ++m_stamp;
+        m_awake = 0;
+        m_transfers.clear();
+        m_movers.clear();
+        m_tilemaps.clear();
+
+        for (auto& partition : m_partitions)
+        {
+            partition.seen = 0;
         }
+
+        // Gather the collider of every object into contiguous memory, from here on the objects are only visited for callbacks.
+        m_colliders.clear();
+        m_colliders.reserve ((unsigned int) objects.size());
+
+        for (auto i = 0U; i < objects.size(); ++i)
+        {
+            const auto object = objects[i];
+
+            // Sleeping objects wake if sleeping has been disabled, they've been made static or something else has moved them.
+            if (object->m_isAsleep && (m_sleepSteps == 0 || object->isStatic() || object->getPosition() != object->m_rest))
+            {
+                object->wake();
+            }
+
+            if (!object->isStatic() && !object->m_isAsleep)
+            {
+                m_movers.push_back (i);
+                ++m_awake;
+            }
+
+            // Sleeping objects are treated as static until they wake. Tilemaps ignore the box and layer of their collider.
+            const auto& collider    = object->getCollider();
+            const auto  tilemap     = object->getTilemap();
+            const auto  isStatic    = object->isStatic() || object->m_isAsleep;
+            const auto  index       = tilemap ? getTilemapPartition() : getPartition (collider.getLayer(), isStatic);
+            auto&       partition   = m_partitions[index];
+
+            const auto  position    = object->getPosition();
+            auto        box         = tilemap ? tilemap->getBounds() : collider.getBox();
+            box.translate (position.x, position.y);
+
+            if (tilemap)
+            {
+                m_tilemaps.emplace_back (i, tilemap);
+            }
+
+            // Continuous objects keep their tight box for queries but their proxy must cover the box they moved from as well.
+            if (object->isContinuous() && !object->isStatic() && !object->m_isAsleep)
+            {
+                const auto displacement = object->getVelocity() * delta;
+                m_colliders.add (box, collider.getLayer(), collider.isTrigger(), collider.getRadius(), displacement);
+
+                const auto left     = box.getLeft() - displacement.x;
+                const auto top      = box.getTop() - displacement.y;
+                const auto right    = box.getRight() - displacement.x;
+                const auto bottom   = box.getBottom() - displacement.y;
+
+                box = { util::min (box.getLeft(), left), util::min (box.getTop(), top),
+                        util::max (box.getRight(), right), util::max (box.getBottom(), bottom) };
+            }
+
+            else
+            {
+                m_colliders.add (box, collider.getLayer(), collider.isTrigger(), tilemap ? 0.f : collider.getRadius());
+            }
+
+            // Objects can be copied or destroyed without our knowledge so the proxy is only trusted if it points back to the object. If
+            // the object has changed layer or become static the old proxy won't be seen this update and will be removed.
+            auto proxy = object->m_proxy;
+
+            if (object->m_partition != index || proxy < 0 || proxy >= (int) partition.proxies.size() ||
+                partition.proxies[proxy].object != object)
+            {
+                // Objects which change partition keep their contacts, the contacts must be told about the new proxy.
+                const auto& previous = m_partitions[object->m_partition].proxies;
+
+                if (object->m_partition != index && proxy >= 0 && proxy < (int) previous.size() && previous[proxy].object == object)
+                {
+                    m_transfers.push_back (object);
+                }
+
+                proxy = partition.tree.createProxy (box);
+                object->m_proxy     = proxy;
+                object->m_partition = index;
+
+                if (partition.proxies.size() < (size_t) partition.tree.getCapacity())
+                {
+                    partition.proxies.resize (partition.tree.getCapacity());
+                }
+
+                partition.proxies[proxy].object = object;
+                ++partition.count;
+            }
+
+            // Moving only restructures the tree if the object has left its fattened box, unmoved statics leave their tree untouched.
+            else
+            {
+                partition.tree.moveProxy (proxy, box);
+            }
+
+            auto& data      = partition.proxies[proxy];
+            data.index      = i;
+            data.stamp      = m_stamp;
+            data.tilemap    = tilemap;
+
+            ++partition.seen;
+        }
+
+        for (auto& partition : m_partitions)
+        {
+            removeStaleProxies (partition);
+        }
+    }
+
+
+    void Physics::integrate (const std::vector<PhysicsObject*>& objects, const float delta)
+    {
+        for (const auto object : objects)
+        {
+            // Sleeping objects must stay where they are, velocities applied to them while asleep are discarded. Attached objects have
+            // already been moved by their TransformStore, their velocity was cleared when they fell asleep or became static.
+            if (object->m_isAsleep)
+            {
+                object->setVelocity ({ 0.f, 0.f });
+            }
+
+            else if (!object->isStatic() && !object->isAttached())
+            {
+                object->m_position += object->m_velocity * delta;
+            }
+        }
+    }
+
+
+    void Physics::removeStaleProxies (Partition& partition)
+    {
+        // Pre-condition: Some proxies weren't seen this update.
+        if (partition.seen == partition.count)
+        {
+            return;
+        }
+
+        for (auto i = 0U; i < partition.proxies.size(); ++i)
+        {
+            auto& data = partition.proxies[i];
+
+            if (data.object && data.stamp != m_stamp)
+            {
+                partition.tree.destroyProxy ((int) i);
+                data.object = nullptr;
+                --partition.count;
+            }
+        }
+    }
+
+
+    void Physics::findPairs()
+    {
+        auto mark = Clock::now();
+
+        // Enough tasks are created for the job system to balance the work, a single thread can traverse each tree in one go.
+        const auto threads  = getThreadCount();
+        const auto split    = threads > 1 ? threads * 8 : 1;
+
+        // Only layers which collide are traversed against each other so disabled combinations cost nothing. Statics are never
+        // tested against each other.
+        m_tasks.clear();
+
+        for (auto layerA = 0U; layerA < 32; ++layerA)
+        {
+            for (auto layerB = layerA; layerB < 32; ++layerB)
+            {
+                if (collides (layerA, layerB))
+                {
+                    addTasks (getPartition (layerA, false), getPartition (layerB, false), split);
+                    addTasks (getPartition (layerA, false), getPartition (layerB, true), split);
+
+                    if (layerA != layerB)
+                    {
+                        addTasks (getPartition (layerB, false), getPartition (layerA, true), split);
+                    }
+                }
+            }
+        }
+
+        for (auto& candidates : m_candidates)
+        {
+            candidates.clear();
+        }
+
+        // Tilemaps aren't traversed, instead the awake objects are split into chunks which look up their tiles in each tilemap. The
+        // tile layers which collide with each layer are found up front so each object only needs a single mask.
+        const auto chunks   = util::min (split, util::max ((unsigned int) m_movers.size(), 1U));
+        const auto traverse = (unsigned int) m_tasks.size();
+        const auto lookups  = (unsigned int) m_tilemaps.size() * chunks;
+
+        if (!m_tilemaps.empty())
+        {
+            for (auto layer = 0U; layer < 32; ++layer)
+            {
+                m_tileLayers[layer] = 0;
+
+                for (auto tileLayer = 0U; tileLayer < 32; ++tileLayer)
+                {
+                    if (collides (layer, tileLayer))
+                    {
+                        m_tileLayers[layer] |= 1U << tileLayer;
+                    }
+                }
+            }
+        }
+
+        // The trees report pairs whose fattened boxes overlap, the tight boxes are tested once they've been grouped.
+        parallel (traverse + lookups, [&] (const unsigned int index, const unsigned int thread)
+        {
+            auto& candidates = m_candidates[thread];
+
+            if (index >= traverse)
+            {
+                findTileCandidates (index - traverse, chunks, candidates);
+                return;
+            }
+
+            const auto& task        = m_tasks[index];
+            const auto& partition   = m_partitions[task.partition];
+            const auto& other       = m_partitions[task.other];
+
+            partition.tree.queryPairs (other.tree, task.entry, [&] (const int proxyA, const int proxyB)
+            {
+                const auto a = partition.proxies[proxyA].index;
+                const auto b = other.proxies[proxyB].index;
+
+                candidates.emplace_back (util::min (a, b), util::max (a, b));
+            });
+        });
+
+        groupCandidates();
+        m_stats.broadphaseTime += lap (mark);
+
+        // Test each object against all of its candidates at once. Each task covers a contiguous range of objects and has its own
+        // output so joining the outputs in order produces sorted pairs, no matter which thread ran which task.
+        const auto count    = m_colliders.size();
+        const auto batches  = util::min (split, count);
+        m_batches.resize (batches);
+
+        parallel (batches, [&] (const unsigned int batch, const unsigned int thread)
+        {
+            auto&       pairs   = m_batches[batch];
+            auto&       hits    = m_hits[thread];
+            const auto  first   = (unsigned int) ((unsigned long long) count * batch / batches);
+            const auto  last    = (unsigned int) ((unsigned long long) count * (batch + 1) / batches);
+
+            pairs.clear();
+
+            for (auto i = first; i < last; ++i)
+            {
+                const auto begin    = i == 0 ? 0 : m_offsets[i - 1];
+                const auto end      = m_offsets[i];
+
+                if (begin == end)
+                {
+                    continue;
+                }
+
+                // Sorting each group maintains the order in which callbacks used to be called when every object was tested against
+                // every other object.
+                std::sort (m_grouped.begin() + begin, m_grouped.begin() + end);
+
+                hits.resize (end - begin);
+                const auto found = m_colliders.intersects (i, m_grouped.data() + begin, end - begin, hits.data());
+
+                for (auto j = 0U; j < found; ++j)
+                {
+                    pairs.emplace_back (i, hits[j]);
+                }
+            }
+        });
+
+        m_pairs.clear();
+
+        for (const auto& pairs : m_batches)
+        {
+            m_pairs.insert (m_pairs.end(), pairs.begin(), pairs.end());
+        }
+
+        m_stats.narrowphaseTime += lap (mark);
+    }
+
+
+    void Physics::parallel (const unsigned int count, const std::function<void (const unsigned int task, const unsigned int thread)>& task)
+    {
+        if (!m_jobs)
+        {
+            for (auto i = 0U; i < count; ++i)
+            {
+                task (i, 0);
+            }
+
+            return;
+        }
+
+        // Each task is a job of its own so stealing balances uneven tasks. The caller must be a thread of the job system, or the one
+        // which created it, so that no two threads can share an index.
+        m_jobs->parallelFor (count, 1, [&] (const unsigned int begin, const unsigned int end)
+        {
+            const auto thread = m_jobs->getThreadIndex();
+
+            for (auto i = begin; i < end; ++i)
+            {
+                task (i, thread);
+            }
+        });
+    }
+
+
+    void Physics::addTasks (const unsigned int partition, const unsigned int other, const unsigned int split)
+    {
+        // Pre-condition: Both partitions contain objects.
+        if (m_partitions[partition].count == 0 || m_partitions[other].count == 0)
+        {
+            return;
+        }
+
+        m_partitions[partition].tree.splitPairs (m_partitions[other].tree, split, m_split);
+
+        for (const auto& entry : m_split)
+        {
+            m_tasks.push_back ({ partition, other, entry });
+        }
+    }
+
+
+    void Physics::findTileCandidates (const unsigned int task, const unsigned int chunks,
+                                      std::vector<std::pair<unsigned int, unsigned int>>& candidates) const
+    {
+        const auto  chunk   = task % chunks;
+        const auto  index   = m_tilemaps[task / chunks].first;
+        const auto& tilemap = *m_tilemaps[task / chunks].second;
+        const auto  bounds  = m_colliders.getBox (index);
+        const auto  count   = (unsigned long long) m_movers.size();
+        const auto  first   = (unsigned int) (count * chunk / chunks);
+        const auto  last    = (unsigned int) (count * (chunk + 1) / chunks);
+
+        for (auto i = first; i < last; ++i)
+        {
+            const auto  mover   = m_movers[i];
+            const auto  layers  = m_tileLayers[m_colliders.getLayer (mover)];
+            auto        box     = m_colliders.getBox (mover);
+
+            // Pre-condition: The object collides with some of the tiles.
+            if (layers == 0)
+            {
+                continue;
+            }
+
+            auto touches = false;
+
+            if (m_colliders.isContinuous (mover))
+            {
+                // Every tile covered by the path is swept against, stopping at the first one touched.
+                const auto displacement = m_colliders.getDisplacement (mover);
+
+                auto start = box;
+                start.translate (-displacement.x, -displacement.y);
+
+                box = { util::min (box.getLeft(), start.getLeft()), util::min (box.getTop(), start.getTop()),
+                        util::max (box.getRight(), start.getRight()), util::max (box.getBottom(), start.getBottom()) };
+                box.translate (-bounds.getLeft(), -bounds.getTop());
+
+                tilemap.forEachTile (box, layers, [&] (Rectangle<float> tile)
+                {
+                    auto time = 0.f;
+                    tile.translate (bounds.getLeft(), bounds.getTop());
+                    touches = m_colliders.sweep (mover, tile, time);
+
+                    return !touches;
+                });
+            }
+
+            // Circles only touch a tile if they reach it, not just the corner of their box.
+            else if (m_colliders.isCircle (mover))
+            {
+                box.translate (-bounds.getLeft(), -bounds.getTop());
+
+                tilemap.forEachTile (box, layers, [&] (Rectangle<float> tile)
+                {
+                    tile.translate (bounds.getLeft(), bounds.getTop());
+                    touches = m_colliders.intersects (mover, tile);
+
+                    return !touches;
+                });
+            }
+
+            else
+            {
+                box.translate (-bounds.getLeft(), -bounds.getTop());
+                touches = tilemap.overlaps (box, layers);
+            }
+
+            if (touches)
+            {
+                candidates.emplace_back (util::min (mover, index), util::max (mover, index));
+            }
+        }
+    }
+
+
+    void Physics::groupCandidates()
+    {
+        // Count the candidates of each object then convert the counts into offsets. Once scattered each offset will be the end of
+        // its group.
+        const auto count = m_colliders.size();
+        auto total = 0U;
+
+        m_offsets.assign (count + 1, 0);
+
+        for (const auto& candidates : m_candidates)
+        {
+            for (const auto& candidate : candidates)
+            {
+                ++m_offsets[candidate.first + 1];
+            }
+
+            total += (unsigned int) candidates.size();
+        }
+
+        for (auto i = 1U; i <= count; ++i)
+        {
+            m_offsets[i] += m_offsets[i - 1];
+        }
+
+        m_grouped.resize (total);
+
+        for (const auto& candidates : m_candidates)
+        {
+            for (const auto& candidate : candidates)
+            {
+                m_grouped[m_offsets[candidate.first]++] = candidate.second;
+            }
+        }
+    }
+
+
+    void Physics::resolvePenetrations (const std::vector<PhysicsObject*>& objects, const float delta)
+    {
+        // Only solid pairs between a non-static and a static object are resolved. Sorting groups the pairs by the non-static object so
+        // each can be resolved against every static it touches in a deterministic order.
+        m_resolve.clear();
+
+        for (const auto& pair : m_pairs)
+        {
+            const auto firstStatic  = objects[pair.first]->isStatic();
+            const auto secondStatic = objects[pair.second]->isStatic();
+
+            if (firstStatic != secondStatic && !m_colliders.isTrigger (pair.first) && !m_colliders.isTrigger (pair.second))
+            {
+                m_resolve.push_back (firstStatic ? std::make_pair (pair.second, pair.first) : pair);
+            }
+        }
+
+        std::sort (m_resolve.begin(), m_resolve.end());
+
+        for (auto begin = 0U; begin < m_resolve.size();)
+        {
+            const auto  index   = m_resolve[begin].first;
+            auto        end     = begin + 1;
+
+            while (end < m_resolve.size() && m_resolve[end].first == index)
+            {
+                ++end;
+            }
+
+            const auto  object      = objects[index];
+            auto        box         = m_colliders.getBox (index);
+            auto        velocity    = object->getVelocity();
+            auto        correction  = Vector2<float> { 0.f, 0.f };
+
+            // We only know how the object moved this update if we moved it or it's continuous.
+            const auto  motion      = m_integration || m_colliders.isContinuous (index) ? velocity * delta : Vector2<float> { 0.f, 0.f };
+
+            // Tilemaps are resolved one solid tile at a time, only tiles on layers the object collides with are considered.
+            const auto layers = m_tileLayers[m_colliders.getLayer (index)];
+
+            const auto gather = [&] (const unsigned int other, const Rectangle<float>& area)
+            {
+                const auto tilemap  = objects[other]->getTilemap();
+                const auto bounds   = m_colliders.getBox (other);
+
+                if (!tilemap)
+                {
+                    m_obstacles.push_back (bounds);
+                    return;
+                }
+
+                auto local = area;
+                local.translate (-bounds.getLeft(), -bounds.getTop());
+
+                tilemap->forEachTile (local, layers, [&] (Rectangle<float> tile)
+                {
+                    tile.translate (bounds.getLeft(), bounds.getTop());
+                    m_obstacles.push_back (tile);
+
+                    return true;
+                });
+            };
+
+            // Continuous objects may have passed straight through a static so they're moved back to the earliest impact first.
+            if (m_colliders.isContinuous (index))
+            {
+                const auto  displacement    = m_colliders.getDisplacement (index);
+                auto        path            = box;
+                auto        earliest        = 1.f;
+
+                path.translate (-displacement.x, -displacement.y);
+                path = { util::min (box.getLeft(), path.getLeft()), util::min (box.getTop(), path.getTop()),
+                         util::max (box.getRight(), path.getRight()), util::max (box.getBottom(), path.getBottom()) };
+
+                m_obstacles.clear();
+
+                for (auto i = begin; i < end; ++i)
+                {
+                    gather (m_resolve[i].second, path);
+                }
+
+                for (const auto& other : m_obstacles)
+                {
+                    auto time = 1.f;
+
+                    if (m_colliders.sweep (index, other, time))
+                    {
+                        earliest = util::min (earliest, time);
+                    }
+                }
+
+                correction -= displacement * (1.f - earliest);
+                box.translate (correction.x, correction.y);
+            }
+
+            // Push the object out of each static in turn, each push is accounted for when testing the next static.
+            const auto push = [&] (const Rectangle<float>& other)
+            {
+                const auto depth = overlap (box, other);
+
+                // Touching isn't penetrating.
+                if (depth.x <= 0.f || depth.y <= 0.f)
+                {
+                    return;
+                }
+
+                // The axis which was only crossed this update is the side the object entered from. Pushing along the other axis would
+                // snag objects on the seams between neighbouring statics, such as the tiles of a floor. Without any motion to go on the
+                // axis of least penetration is used.
+                auto previous = box;
+                previous.translate (-motion.x, -motion.y);
+
+                const auto  before      = overlap (previous, other);
+                const auto  enteredX    = before.y > 0.f && before.x <= 0.f;
+                const auto  enteredY    = before.x > 0.f && before.y <= 0.f;
+
+                // The object leaves through the side it entered from, otherwise through whichever side is closest.
+                const auto  exitX       = exit (box.getLeft(), box.getRight(), other.getLeft(), other.getRight(), enteredX ? motion.x : 0.f);
+                const auto  exitY       = exit (box.getTop(), box.getBottom(), other.getTop(), other.getBottom(), enteredY ? motion.y : 0.f);
+                auto        move        = Vector2<float> { 0.f, 0.f };
+
+                if (enteredX || (!enteredY && std::abs (exitX) < std::abs (exitY)))
+                {
+                    move.x = exitX;
+
+                    if (velocity.x * move.x < 0.f)
+                    {
+                        velocity.x = 0.f;
+                    }
+                }
+
+                else
+                {
+                    move.y = exitY;
+
+                    if (velocity.y * move.y < 0.f)
+                    {
+                        velocity.y = 0.f;
+                    }
+                }
+
+                box.translate (move.x, move.y);
+                correction += move;
+            };
+
+            for (auto i = begin; i < end; ++i)
+            {
+                m_obstacles.clear();
+                gather (m_resolve[i].second, box);
+
+                for (const auto& other : m_obstacles)
+                {
+                    push (other);
+                }
+            }
+
+            begin = end;
+
+            // Pre-condition: The object actually needs moving.
+            if (correction.x == 0.f && correction.y == 0.f)
+            {
+                continue;
+            }
+
+            // Keep queries consistent with the resolved position.
+            object->setPosition (object->getPosition() + correction);
+            object->setVelocity (velocity);
+            m_colliders.setBox (index, box);
+            m_partitions[object->m_partition].tree.moveProxy (object->m_proxy, box);
+        }
+    }
+
+
+    void Physics::updateSleep (const std::vector<PhysicsObject*>& objects)
+    {
+        // Every object starts in its own island. Objects which have moved further than the tolerance since the last update are no
+        // longer still, an object which is still this update will have a non-zero count.
+        const auto count        = (unsigned int) objects.size();
+        const auto tolerance    = m_sleepTolerance * m_sleepTolerance;
+
+        m_islands.resize (count);
+        m_islandSteps.assign (count, ~0U);
+
+        for (auto i = 0U; i < count; ++i)
+        {
+            const auto object = objects[i];
+            m_islands[i] = i;
+
+            if (!object->isStatic() && !object->m_isAsleep)
+            {
+                const auto moved = (object->getPosition() - object->m_rest).squareMagnitude() > tolerance;
+
+                object->m_stillSteps    = moved ? 0 : util::min (object->m_stillSteps + 1, m_sleepSteps);
+                object->m_rest          = object->getPosition();
+            }
+        }
+
+        // Touching objects are joined into islands. Sleeping objects are in the static trees so they're only paired with awake
+        // objects, a sleeping object is woken if the awake object moved into it.
+        for (const auto& pair : m_pairs)
+        {
+            const auto first    = objects[pair.first];
+            const auto second   = objects[pair.second];
+
+            if (first->isStatic() || second->isStatic())
+            {
+                continue;
+            }
+
+            if (first->m_isAsleep != second->m_isAsleep)
+            {
+                const auto sleeper  = first->m_isAsleep ? first : second;
+                const auto mover    = first->m_isAsleep ? second : first;
+
+                if (mover->m_stillSteps == 0)
+                {
+                    sleeper->wake();
+                    ++m_awake;
+                }
+            }
+
+            else if (!first->m_isAsleep)
+            {
+                m_islands[findIsland (pair.first)] = findIsland (pair.second);
+            }
+        }
+
+        // An island can only sleep once every object in it has been still for long enough.
+        for (auto i = 0U; i < count; ++i)
+        {
+            if (!objects[i]->isStatic() && !objects[i]->m_isAsleep)
+            {
+                auto& steps = m_islandSteps[findIsland (i)];
+                steps       = util::min (steps, objects[i]->m_stillSteps);
+            }
+        }
+
+        for (auto i = 0U; i < count; ++i)
+        {
+            const auto object = objects[i];
+
+            if (!object->isStatic() && !object->m_isAsleep && m_islandSteps[findIsland (i)] >= m_sleepSteps)
+            {
+                object->m_isAsleep = true;
+                --m_awake;
+
+                // Only clear the velocity if something integrates it, attached objects are always moved by their store.
+                if (m_integration || object->isAttached())
+                {
+                    object->setVelocity ({ 0.f, 0.f });
+                }
+            }
+        }
+    }
+
+
+    unsigned int Physics::findIsland (unsigned int index)
+    {
+        // Halve the path on the way up so future searches are quicker.
+        while (m_islands[index] != index)
+        {
+            m_islands[index] = m_islands[m_islands[index]];
+            index            = m_islands[index];
+        }
+
+        return index;
+    }
+
+
+    void Physics::updateProjectiles (const float delta)
+    {
+        m_projectileHits.clear();
+
+        // Pre-condition: There are projectiles to move.
+        if (m_projectiles.size() == 0)
+        {
+            return;
+        }
+
+        m_stats.projectiles = m_projectiles.size();
+        m_projectiles.integrate (delta);
+
+        // Find which partitions each layer of projectile needs to search up front, empty partitions are skipped entirely.
+        for (auto layer = 0U; layer < 32; ++layer)
+        {
+            auto& targets = m_targets[layer];
+            targets.clear();
+
+            for (auto other = 0U; other < 32; ++other)
+            {
+                if (collides (layer, other))
+                {
+                    for (const auto partition : { getPartition (other, false), getPartition (other, true) })
+                    {
+                        if (m_partitions[partition].count != 0)
+                        {
+                            targets.push_back (partition);
+                        }
+                    }
+                }
+            }
+
+            if (!m_tilemaps.empty() && m_tileLayers[layer] != 0)
+            {
+                targets.push_back (getTilemapPartition());
+            }
+        }
+
+        // Each task sweeps a contiguous range of projectiles into its own output, so joining them keeps the hits in order.
+        const auto count    = m_projectiles.size();
+        const auto threads  = getThreadCount();
+        const auto tasks    = util::min (threads > 1 ? threads * 8 : 1, count);
+        m_hitBatches.resize (tasks);
+        m_sweepTests.assign (tasks, 0);
+
+        parallel (tasks, [&] (const unsigned int task, const unsigned int thread)
+        {
+            auto&       hits    = m_hitBatches[task];
+            auto&       found   = m_sweeps[thread];
+            const auto  first   = (unsigned int) ((unsigned long long) count * task / tasks);
+            const auto  last    = (unsigned int) ((unsigned long long) count * (task + 1) / tasks);
+
+            hits.clear();
+
+            for (auto i = first; i < last; ++i)
+            {
+                sweepProjectile (i, found, m_sweepTests[task]);
+
+                // Projectiles which aren't persistent stop at the first solid collider, triggers before it are still reported.
+                const auto persistent = m_projectiles.isPersistent (i);
+
+                for (const auto& entry : found)
+                {
+                    hits.push_back (entry.second);
+
+                    if (!persistent && !entry.second.trigger)
+                    {
+                        m_projectiles.mark (i);
+                        break;
+                    }
+                }
+            }
+        });
+
+        for (auto task = 0U; task < tasks; ++task)
+        {
+            const auto& hits = m_hitBatches[task];
+
+            m_projectileHits.insert (m_projectileHits.end(), hits.begin(), hits.end());
+            m_stats.narrowphaseTests += m_sweepTests[task];
+        }
+
+        m_projectiles.removeMarked();
+        m_stats.projectileHits = (unsigned int) m_projectileHits.size();
+
+        if (m_hitHandler && !m_projectileHits.empty())
+        {
+            m_hitHandler (m_projectileHits.data(), (unsigned int) m_projectileHits.size());
+            ++m_stats.handlerCalls;
+        }
+    }
+
+
+    void Physics::sweepProjectile (const unsigned int index, std::vector<std::pair<unsigned int, ProjectileHit>>& found,
+                                   unsigned int& tests) const
+    {
+        const auto  end     = m_projectiles.getPosition (index);
+        const auto  move    = m_projectiles.getDisplacement (index);
+        const auto  start   = end - move;
+        const auto  radius  = m_projectiles.getRadius (index);
+        const auto  layer   = m_projectiles.getLayer (index);
+
+        // The box covering the whole path, the trees only return objects whose fattened boxes overlap it.
+        const auto  path    = Rectangle<float> { util::min (start.x, end.x) - radius, util::min (start.y, end.y) - radius,
+                                                 util::max (start.x, end.x) + radius, util::max (start.y, end.y) + radius };
+
+        found.clear();
+
+        const auto add = [&] (const Proxy& data, const float fraction, const Vector2<float>& normal)
+        {
+            auto hit    = ProjectileHit { };
+            hit.object  = data.object;
+            hit.point   = start + move * fraction;
+            hit.normal  = normal;
+            hit.time    = fraction;
+            hit.id      = m_projectiles.getID (index);
+            hit.trigger = m_colliders.isTrigger (data.index);
+
+            found.emplace_back (data.index, hit);
+        };
+
+        for (const auto target : m_targets[layer])
+        {
+            const auto& partition = m_partitions[target];
+
+            partition.tree.query (path, [&] (const int proxy)
+            {
+                const auto& data        = partition.proxies[proxy];
+                const auto  box         = m_colliders.getBox (data.index);
+                auto        fraction    = 0.f;
+                auto        normal      = Vector2<float> { };
+
+                // Tilemaps report the earliest tile on a colliding layer, each tile grown by the radius like any other box.
+                if (data.tilemap)
+                {
+                    auto local = path;
+                    local.translate (-box.getLeft(), -box.getTop());
+
+                    auto earliest   = 2.f;
+                    auto surface    = Vector2<float> { };
+
+                    data.tilemap->forEachTile (local, m_tileLayers[layer], [&] (Rectangle<float> tile)
+                    {
+                        ++tests;
+                        tile = { tile.getLeft() + box.getLeft() - radius, tile.getTop() + box.getTop() - radius,
+                                 tile.getRight() + box.getLeft() + radius, tile.getBottom() + box.getTop() + radius };
+
+                        if (intersectRay (start, move, tile, 1.f, fraction, normal) && fraction < earliest)
+                        {
+                            earliest    = fraction;
+                            surface     = normal;
+                        }
+
+                        return true;
+                    });
+
+                    if (earliest <= 1.f)
+                    {
+                        add (data, earliest, surface);
+                    }
+                }
+
+                else if (m_colliders.isCircle (data.index))
+                {
+                    ++tests;
+                    const auto other    = m_colliders.getRadius (data.index);
+                    const auto centre   = Vector2<float> { box.getLeft() + other, box.getTop() + other };
+
+                    if (intersectCircle (start, move, centre, other + radius, 1.f, fraction, normal))
+                    {
+                        add (data, fraction, normal);
+                    }
+                }
+
+                else
+                {
+                    ++tests;
+                    const auto grown = Rectangle<float> { box.getLeft() - radius, box.getTop() - radius,
+                                                          box.getRight() + radius, box.getBottom() + radius };
+
+                    if (intersectRay (start, move, grown, 1.f, fraction, normal))
+                    {
+                        add (data, fraction, normal);
+                    }
+                }
+
+                return true;
+            });
+        }
+
+        // Order by time, ties are broken by the order the objects were given in so hits never depend on the shape of the trees.
+        std::sort (found.begin(), found.end(), [] (const std::pair<unsigned int, ProjectileHit>& lhs,
+                                                   const std::pair<unsigned int, ProjectileHit>& rhs)
+        {
+            return lhs.second.time != rhs.second.time ? lhs.second.time < rhs.second.time : lhs.first < rhs.first;
+        });
+    }
+
+
+    void Physics::refreshContacts()
+    {
+        // Pre-condition: Some objects have changed partition.
+        if (m_transfers.empty())
+        {
+            return;
+        }
+
+        std::sort (m_transfers.begin(), m_transfers.end());
+
+        // Objects which have been transferred were given to this update so they can be accessed safely.
+        for (auto& entry : m_contacts)
+        {
+            auto& contact = entry.second;
+
+            if (std::binary_search (m_transfers.begin(), m_transfers.end(), contact.first))
+            {
+                contact.firstProxy      = contact.first->m_proxy;
+                contact.firstPartition  = contact.first->m_partition;
+            }
+
+            if (std::binary_search (m_transfers.begin(), m_transfers.end(), contact.second))
+            {
+                contact.secondProxy     = contact.second->m_proxy;
+                contact.secondPartition = contact.second->m_partition;
+            }
+        }
+    }
+
+
+    void Physics::updateContact (const std::vector<PhysicsObject*>& objects, const std::pair<unsigned int, unsigned int>& pair)
+    {
+        const auto first    = objects[pair.first];
+        const auto second   = objects[pair.second];
+        const auto key      = first < second ? std::make_pair (first, second) : std::make_pair (second, first);
+        const auto result   = m_contacts.emplace (key, Contact { });
+        const auto isNew    = result.second;
+        auto&      contact  = result.first->second;
+
+        // Refresh the contact as the order and state of the objects may have changed since it was last seen.
+        contact.first           = first;
+        contact.second          = second;
+        contact.firstIndex      = pair.first;
+        contact.secondIndex     = pair.second;
+        contact.firstProxy      = first->m_proxy;
+        contact.secondProxy     = second->m_proxy;
+        contact.firstPartition  = first->m_partition;
+        contact.secondPartition = second->m_partition;
+        contact.firstLayer      = m_colliders.getLayer (pair.first);
+        contact.secondLayer     = m_colliders.getLayer (pair.second);
+        contact.firstTrigger    = m_colliders.isTrigger (pair.first);
+        contact.secondTrigger   = m_colliders.isTrigger (pair.second);
+        contact.stamp           = m_stamp;
+
+        // Pre-condition: The contact has an event to deliver.
+        if (!isNew && !m_stayEvents)
+        {
+            return;
+        }
+
+        const auto event = isNew ? ContactEvent::Enter : ContactEvent::Stay;
+
+        if (!batchContact (event, contact, first, second))
+        {
+            dispatch (event, first, contact.firstTrigger, second, contact.secondTrigger, m_stats);
+        }
+    }
+
+
+    void Physics::removeStaleContacts()
+    {
+        m_exits.clear();
+
+        for (auto i = m_contacts.begin(); i != m_contacts.end();)
+        {
+            auto& contact = i->second;
+
+            // Objects in the static partitions are never tested against each other so contacts between sleeping objects, or a
+            // sleeping object and a static object, are kept until one of them wakes. Stay events aren't called for them.
+            if (contact.stamp != m_stamp && isStaticPartition (contact.firstPartition) && isStaticPartition (contact.secondPartition) &&
+                exists (contact.first, contact.firstProxy, contact.firstPartition) &&
+                exists (contact.second, contact.secondProxy, contact.secondPartition))
+            {
+                contact.firstIndex  = m_partitions[contact.firstPartition].proxies[contact.firstProxy].index;
+                contact.secondIndex = m_partitions[contact.secondPartition].proxies[contact.secondProxy].index;
+                contact.stamp       = m_stamp;
+            }
+
+            if (contact.stamp != m_stamp)
+            {
+                m_exits.push_back (contact);
+                i = m_contacts.erase (i);
+            }
+
+            else
+            {
+                ++i;
+            }
+        }
+
+        // The map has no meaningful order so sort by the indices the objects last had, this keeps exit events deterministic.
+        std::sort (m_exits.begin(), m_exits.end(), [] (const Contact& lhs, const Contact& rhs)
+        {
+            return lhs.firstIndex != rhs.firstIndex ? lhs.firstIndex < rhs.firstIndex : lhs.secondIndex < rhs.secondIndex;
+        });
+
+        for (const auto& contact : m_exits)
+        {
+            // Removed objects may have been destroyed so they must not be accessed.
+            const auto first    = exists (contact.first, contact.firstProxy, contact.firstPartition) ? contact.first : nullptr;
+            const auto second   = exists (contact.second, contact.secondProxy, contact.secondPartition) ? contact.second : nullptr;
+
+            if (!batchContact (ContactEvent::Exit, contact, first, second))
+            {
+                dispatch (ContactEvent::Exit, first, contact.firstTrigger, second, contact.secondTrigger, m_stats);
+            }
+        }
+
+        callHandlers (ContactEvent::Exit);
+    }
+
+
+    bool Physics::batchContact (const ContactEvent event, const Contact& contact, PhysicsObject* const first, PhysicsObject* const second)
+    {
+        // Pre-condition: A handler has been registered for the layers.
+        if (m_routes.empty() || m_routes[contact.firstLayer * 32 + contact.secondLayer] == ~0U)
+        {
+            return false;
+        }
+
+        // Pairs are flipped so the first object is always on the first layer the handler was registered with.
+        auto& handler = m_handlers[m_routes[contact.firstLayer * 32 + contact.secondLayer]];
+        auto& batch   = handler.batches[(size_t) event];
+
+        if (contact.firstLayer == handler.layer)
+        {
+            batch.push_back ({ first, second, contact.firstTrigger, contact.secondTrigger });
+        }
+
+        else
+        {
+            batch.push_back ({ second, first, contact.secondTrigger, contact.firstTrigger });
+        }
+
+        return true;
+    }
+
+
+    void Physics::callHandlers (const ContactEvent event)
+    {
+        // Batches keep their memory so handling contacts doesn't allocate once the update has settled.
+        for (auto& handler : m_handlers)
+        {
+            auto& batch = handler.batches[(size_t) event];
+
+            if (!batch.empty())
+            {
+                handler.function (event, batch.data(), (unsigned int) batch.size());
+                batch.clear();
+                ++m_stats.handlerCalls;
+            }
+        }
+    }
+
+
+    bool Physics::exists (const PhysicsObject* const object, const int proxy, const unsigned int partition) const
+    {
+        // The proxies of objects which weren't given to the current update have already been removed.
+        const auto& proxies = m_partitions[partition].proxies;
+
+        return proxy >= 0 && proxy < (int) proxies.size() && proxies[proxy].object == object && proxies[proxy].stamp == m_stamp;
+    }
+
+
+    bool Physics::raycast (const Partition& partition, const Vector2<float>& origin, const Vector2<float>& normal, const float distance,
+                           RaycastHit& hit) const
+    {
+        // Pre-condition: There is a distance to search.
+        if (distance <= 0.f)
+        {
+            return false;
+        }
+
+        const auto  delta   = normal * distance;
+        auto        found   = false;
+
+        partition.tree.raycast (origin, origin + delta, [&] (const int proxy, const float maxFraction)
+        {
+            const auto& data        = partition.proxies[proxy];
+            auto        fraction    = 0.f;
+            auto        surface     = Vector2<float> { };
+
+            // Ignore the proxy if the ray misses its tight box, its circle, or every solid tile of its tilemap.
+            const auto box      = m_colliders.getBox (data.index);
+            const auto radius   = m_colliders.getRadius (data.index);
+            const auto centre   = Vector2<float> { box.getLeft() + radius, box.getTop() + radius };
+            const auto isHit    = data.tilemap      ? intersectTiles (*data.tilemap, box, origin, delta, maxFraction, fraction, surface) :
+                                  radius > 0.f      ? intersectCircle (origin, delta, centre, radius, maxFraction, fraction, surface) :
+                                                      intersectRay (origin, delta, box, maxFraction, fraction, surface);
+
+            if (!isHit)
+            {
+                return -1.f;
+            }
+
+            // Clip the ray so only closer objects are considered from now on.
+            hit.object      = data.object;
+            hit.distance    = fraction * distance;
+            hit.point       = origin + normal * hit.distance;
+            hit.normal      = surface;
+            found           = true;
+
+            return fraction;
+        });
+
+        return found;
     }
 }
@@ -2,15 +2,41 @@
 #define WATER_PHYSICS_INCLUDED
 
 
+// STL headers.
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+
 // Engine headers.
+#include <GameComponents/TilemapCollider.hpp>
+#include <Misc/Rectangle.hpp>
 #include <Systems/IEnginePhysics.hpp>
+#include <Systems/Physics/AABBTree.hpp>
+#include <Systems/Physics/ColliderBuffer.hpp>
+#include <Systems/Physics/ProjectilePool.hpp>
+#include <Utility/JobSystem.hpp>
+#include <Utility/RingBuffer.hpp>
 
 
 // Engine namespace.
 namespace water
 {
     /// <summary>
-    /// A basic physics engine which checks the rectangular collisions of each object passed to it.
+    /// A basic physics engine which checks the rectangular and circular collisions of each object passed to it. Every object is given a proxy in a
+    /// dynamic AABB tree which is refitted as objects move, the trees are used both to find candidate pairs and to answer queries. Each
+    /// layer has its own trees so only layers which collide according to the layer masks are ever tested against each other. Static
+    /// objects are kept in separate trees which are only modified when statics are added, removed or moved, static objects are never
+    /// tested against each other. Pairs can be found using the threads of a job system, callbacks are always called on the calling thread
+    /// in the same order regardless of how many threads are used. Contacts are remembered between updates so that objects can be told when
+    /// contact begins, continues and ends. Dynamic objects may opt in to continuous collision detection, their colliders are swept
+    /// along the path they moved so they can't tunnel through thin objects. Objects which stop moving can be put to sleep, sleeping
+    /// objects are kept in the static trees until they wake. Objects with a tilemap are kept in a partition of their own which is never
+    /// traversed, instead each awake object looks up the tiles its box covers in every tilemap it touches. Contacts between layers
+    /// with a registered handler are collected during the update and given to the handler in batches rather than to each object.
+    /// Projectiles are kept in a pool of plain data, once the objects have settled they're moved together and swept against the trees.
+    /// Every update is measured and the measurements of recent updates can be kept for debugging tools.
     /// </summary>
     class Physics final : public IEnginePhysics
     {
@@ -21,8 +47,8 @@ namespace water
             ///////////////////////////////////
 
             Physics()                                   = default;
-            Physics (const Physics& copy)               = default;
-            Physics& operator= (const Physics& copy)    = default;
+            Physics (const Physics& copy)               = delete;
+            Physics& operator= (const Physics& copy)    = delete;
 
             Physics (Physics&& move);
             Physics& operator= (Physics&& move);
@@ -34,18 +60,35 @@ namespace water
             /////////////////////////
 
             /// <summary> Initialise the system, preparing it for checking collisions. </summary>
-            void initialise() override final;
+            /// <param name="margin"> How far objects may move before the broadphase tree needs restructuring. Must not be negative. </param>
+            /// <param name="jobs"> The job system to spread collision detection across, nullptr runs it all on the calling thread. </param>
+            void initialise (const float margin, util::JobSystem* const jobs) override final;
 
             /// <summary> Checks for collisions in all given PhysicsObject's. </summary>
             /// <param name="objects"> The objects to check collision for. </param>
-            void detectCollisions (const std::vector<PhysicsObject*>& objects) override final;
+            /// <param name="delta"> The length of the physics update in seconds, used to find where continuous objects moved from. </param>
+            void detectCollisions (const std::vector<PhysicsObject*>& objects, const float delta) override final;
+
+            /// <summary>
+            /// Performs several fixed physics updates back to back. This is a convenience wrapper which calls detectCollisions() once
+            /// per step, no broadphase work is shared between the steps beyond the trees and buffers every update keeps.
+            /// </summary>
+            /// <param name="objects"> The objects to check collision for, the collection may change between steps. </param>
+            /// <param name="delta"> The length of each physics update in seconds. </param>
+            /// <param name="steps"> The number of physics updates to perform. </param>
+            /// <param name="beforeStep"> Called at the start of every step, may be empty. </param>
+            void simulate (const std::vector<PhysicsObject*>& objects, const float delta, const unsigned int steps,
+                           const std::function<void()>& beforeStep) override final;
 
 
             ////////////////////////
             /// Layer management ///
             ////////////////////////
 
-            /// <summary> Set the layer mask to use for a given layer. This will effect what objects collide with it. </summary
+            /// <summary>
+            /// Set the layer mask to use for a given layer. This will effect what objects collide with it. Two objects only collide if
+            /// the mask of each layer contains the other layer, every layer collides with every layer by default.
+            /// </summary>
             /// <param name="layer"> The layer to set the layer mask of. Must be lower than 32. </param>
             /// <param name="collidable"> The layermask to use for collision detection, each individual bit represents a layer. </param>
             void setLayerMask (const unsigned int layer, const unsigned int collidable) override final;
@@ -60,13 +103,374 @@ namespace water
             /// <param name="layerToAdd"> The layer to remove from the collision mask, must be lower than 32. </param>
             void removeFromMask (const unsigned int layerToModify, const unsigned int layerToAdd) override final;
 
+
+            //////////////
+            /// Events ///
+            //////////////
+
+            /// <summary> Sets whether onCollisionStay() and onTriggerStay() are called for contacts which persist between updates. </summary>
+            /// <param name="enabled"> Whether stay events should be delivered. </param>
+            void setStayEvents (const bool enabled) override final  { m_stayEvents = enabled; }
+
+            /// <summary> Indicates whether stay events are currently being delivered. </summary>
+            bool hasStayEvents() const override final               { return m_stayEvents; }
+
+            /// <summary> Routes the contacts between two layers to a handler instead of the event functions of each PhysicsObject. </summary>
+            /// <param name="layerA"> The layer of the first object in each pair. Must be lower than 32. </param>
+            /// <param name="layerB"> The layer of the second object in each pair. Must be lower than 32. </param>
+            /// <param name="handler"> The function to call, an empty function returns the contacts to the objects. </param>
+            void setContactHandler (const unsigned int layerA, const unsigned int layerB, const ContactHandler& handler) override final;
+
+
+            //////////////////
+            /// Simulation ///
+            //////////////////
+
+            /// <summary> Sets whether every non-static object is moved by its velocity at the start of each physics update. </summary>
+            /// <param name="enabled"> Whether velocities should be integrated. </param>
+            void setIntegration (const bool enabled) override final { m_integration = enabled; }
+
+            /// <summary> Indicates whether velocities are currently being integrated. </summary>
+            bool hasIntegration() const override final              { return m_integration; }
+
+            /// <summary> Sets whether non-static objects are pushed out of the static objects they penetrate. </summary>
+            /// <param name="enabled"> Whether penetrations should be resolved. </param>
+            void setResolution (const bool enabled) override final  { m_resolution = enabled; }
+
+            /// <summary> Indicates whether penetrations are currently being resolved. </summary>
+            bool hasResolution() const override final               { return m_resolution; }
+
+            /// <summary> Sets how many physics updates a non-static object must stay still for before being put to sleep. </summary>
+            /// <param name="steps"> The number of still updates required, zero disables sleeping. </param>
+            /// <param name="tolerance"> How far an object may move during an update while still being considered still. Must not be negative. </param>
+            void setSleeping (const unsigned int steps, const float tolerance) override final;
+
+            /// <summary> Obtains how many physics updates an object must be still for before sleeping, zero if sleeping is disabled. </summary>
+            unsigned int getSleepSteps() const override final       { return m_sleepSteps; }
+
+
+            ///////////////////
+            /// Projectiles ///
+            ///////////////////
+
+            /// <summary> Adds a projectile to the pool, it will first move during the next physics update. </summary>
+            /// <param name="projectile"> The projectile to add. </param>
+            void addProjectile (const Projectile& projectile) override final    { m_projectiles.add (projectile); }
+
+            /// <summary> Removes every projectile from the pool. </summary>
+            void clearProjectiles() override final                              { m_projectiles.clear(); }
+
+            /// <summary> Obtains how many projectiles are in the pool. </summary>
+            unsigned int getProjectileCount() const override final              { return m_projectiles.size(); }
+
+            /// <summary> Obtains every projectile hit from the most recent physics update. </summary>
+            const std::vector<ProjectileHit>& getProjectileHits() const override final  { return m_projectileHits; }
+
+            /// <summary> Sets a function to be given the hits at the end of every physics update in which a projectile hit something. </summary>
+            /// <param name="handler"> The function to call, may be empty. </param>
+            void setProjectileHandler (const ProjectileHandler& handler) override final { m_hitHandler = handler; }
+
+
+            ///////////////////
+            /// Diagnostics ///
+            ///////////////////
+
+            /// <summary> Obtains the measurements taken during the most recent physics update. </summary>
+            const PhysicsStats& getStats() const override final     { return m_stats; }
+
+            /// <summary> Obtains how many threads collision detection uses, those of the job system or only the calling thread. </summary>
+            unsigned int getThreadCount() const override final      { return m_jobs ? m_jobs->getThreadCount() : 1; }
+
+            /// <summary> Sets how many physics updates worth of measurements are kept. </summary>
+            /// <param name="updates"> How many updates to keep, zero disables the history. Existing history is discarded. </param>
+            void setStatsHistory (const unsigned int updates) override final    { m_history.setCapacity (updates); }
+
+            /// <summary> Obtains how many physics updates worth of measurements are currently kept. </summary>
+            unsigned int getStatsHistorySize() const override final             { return m_history.size(); }
+
+            /// <summary> Obtains the measurements of a recent physics update, zero is the oldest update kept. </summary>
+            /// <param name="index"> Must be lower than getStatsHistorySize(), std::out_of_range is thrown otherwise. </param>
+            const PhysicsStats& getStatsHistory (const unsigned int index) const override final;
+
+            /// <summary> Obtains how many non-static objects were awake at the end of the most recent physics update. </summary>
+            unsigned int getAwakeCount() const override final       { return m_awake; }
+
+            /// <summary> Obtains how many candidate pairs had their colliders tested during the most recent physics update. </summary>
+            unsigned int getTestedPairCount() const override final  { return (unsigned int) m_grouped.size(); }
+
+            /// <summary> Obtains how many pairs of colliders were found to overlap during the most recent physics update. </summary>
+            unsigned int getOverlapCount() const override final     { return (unsigned int) m_pairs.size(); }
+
+
+            ///////////////
+            /// Queries ///
+            ///////////////
+
+            /// <summary> Finds every object whose collider intersects the given region, as of the most recent physics update. </summary>
+            /// <param name="region"> The world-space area to search. </param>
+            /// <param name="results"> The container to fill with each object found, existing contents will be cleared. </param>
+            void queryRegion (const Rectangle<float>& region, std::vector<PhysicsObject*>& results) const override final;
+
+            /// <summary> Performs many region queries at once, each only finding objects on layers which collide with the layer of the region. </summary>
+            /// <param name="regions"> The world-space area of each query. </param>
+            /// <param name="layers"> The layer of each query, regions on invalid layers find nothing. </param>
+            /// <param name="count"> The number of queries. </param>
+            /// <param name="results"> The container to fill with each object found, ordered by region. Existing contents will be cleared. </param>
+            void queryRegions (const Rectangle<float>* const regions, const unsigned int* const layers, const unsigned int count,
+                               std::vector<RegionOverlap>& results) const override final;
+
+            /// <summary> Finds every object whose collider contains the given point, as of the most recent physics update. </summary>
+            /// <param name="point"> The world-space point to test. </param>
+            /// <param name="results"> The container to fill with each object found, existing contents will be cleared. </param>
+            void queryPoint (const Vector2<float>& point, std::vector<PhysicsObject*>& results) const override final;
+
+            /// <summary> Casts a ray through the world, finding the closest object it hits as of the most recent physics update. </summary>
+            /// <param name="origin"> The world-space point the ray starts from. </param>
+            /// <param name="direction"> The direction of the ray, this doesn't need to be normalised. </param>
+            /// <param name="distance"> How far the ray travels. </param>
+            /// <param name="hit"> Filled with information about the closest hit, if any. </param>
+            /// <returns> Whether the ray hit anything. </returns>
+            bool raycast (const Vector2<float>& origin, const Vector2<float>& direction, const float distance, RaycastHit& hit) const override final;
+
         private:
 
+            /// <summary> The information the system keeps about each proxy in the tree. </summary>
+            struct Proxy final
+            {
+                PhysicsObject*          object  { nullptr };    //!< The object the proxy represents, nullptr if the node isn't a proxy.
+                unsigned int            index   { 0 };          //!< The index of the object in the collection given during the latest update.
+                unsigned int            stamp   { 0 };          //!< The update in which the object was last seen.
+                const TilemapCollider*  tilemap { nullptr };    //!< The tilemap of the object during the latest update, if any.
+            };
+
+
+            /// <summary> A pair of objects which were in contact, the first object had the lower index when last seen. </summary>
+            struct Contact final
+            {
+                PhysicsObject*  first           { nullptr };    //!< The first object in contact.
+                PhysicsObject*  second          { nullptr };    //!< The second object in contact.
+                unsigned int    firstIndex      { 0 };          //!< The index of the first object when the contact was last seen.
+                unsigned int    secondIndex     { 0 };          //!< The index of the second object when the contact was last seen.
+                int             firstProxy      { -1 };         //!< The proxy of the first object, used to check if it still exists.
+                int             secondProxy     { -1 };         //!< The proxy of the second object, used to check if it still exists.
+                unsigned int    firstPartition  { 0 };          //!< The partition containing the proxy of the first object.
+                unsigned int    secondPartition { 0 };          //!< The partition containing the proxy of the second object.
+                unsigned int    firstLayer      { 0 };          //!< The layer of the first object, used to find its handler.
+                unsigned int    secondLayer     { 0 };          //!< The layer of the second object, used to find its handler.
+                bool            firstTrigger    { false };      //!< Whether the first object was a trigger.
+                bool            secondTrigger   { false };      //!< Whether the second object was a trigger.
+                unsigned int    stamp           { 0 };          //!< The update in which the contact was last seen.
+            };
+
+
+            /// <summary> A registered contact handler along with the contacts waiting to be given to it. </summary>
+            struct Handler final
+            {
+                ContactHandler              function    { };    //!< The function to call, empty if the handler has been removed.
+                unsigned int                layer       { 0 };  //!< The layer which the first object of each pair must be on.
+                std::vector<ContactPair>    batches[3]  { };    //!< The contacts of each event waiting to be handled, indexed by event.
+            };
+
+
+            /// <summary> Hashes a pair of objects, used to find contacts. </summary>
+            struct ContactHash final
+            {
+                size_t operator() (const std::pair<PhysicsObject*, PhysicsObject*>& pair) const
+                {
+                    const auto first    = std::hash<PhysicsObject*>() (pair.first);
+                    const auto second   = std::hash<PhysicsObject*>() (pair.second);
+
+                    return first ^ (second + 0x9e3779b9 + (first << 6) + (first >> 2));
+                }
+            };
+
+
+            /// <summary> Every contact, keyed by the objects in address order. </summary>
+            using ContactMap = std::unordered_map<std::pair<PhysicsObject*, PhysicsObject*>, Contact, ContactHash>;
+
+
+            /// <summary> A broadphase tree along with the information kept about each of its proxies. </summary>
+            struct Partition final
+            {
+                AABBTree            tree    { };    //!< The tree containing a proxy for every object in the partition.
+                std::vector<Proxy>  proxies { };    //!< Information about each proxy, indexed by the ID of the proxy.
+                unsigned int        count   { 0 };  //!< The number of proxies in the tree.
+                unsigned int        seen    { 0 };  //!< The number of proxies seen during the current update.
+            };
+
+
+            /// <summary> A portion of the traversal of two partitions, produced by AABBTree::splitPairs(). </summary>
+            struct Task final
+            {
+                unsigned int        partition   { 0 };  //!< The dynamic partition being traversed.
+                unsigned int        other       { 0 };  //!< The partition being traversed against, this may be the same partition.
+                std::pair<int, int> entry       { };    //!< The nodes of each partition to start the traversal from.
+            };
+
+
+            /// <summary> Obtains the partition which contains objects of the given layer and type. </summary>
+            static unsigned int getPartition (const unsigned int layer, const bool isStatic) { return layer * 2 + (isStatic ? 1 : 0); }
+
+            /// <summary> Obtains the partition which contains every object with a tilemap, regardless of layer. </summary>
+            static unsigned int getTilemapPartition()   { return 64; }
+
+            /// <summary> Checks whether a partition only contains objects which aren't moving, sleeping objects included. </summary>
+            static bool isStaticPartition (const unsigned int partition) { return (partition & 1) != 0 || partition == getTilemapPartition(); }
+
+            /// <summary> Checks whether the layer masks allow objects on the given layers to collide. </summary>
+            bool collides (const unsigned int layerA, const unsigned int layerB) const
+            {
+                return (m_layers[layerA] & (1U << layerB)) != 0 && (m_layers[layerB] & (1U << layerA)) != 0;
+            }
+
+
+            /////////////////////////
+            /// Internal workings ///
+            /////////////////////////
+
+            /// <summary>
+            /// Ensures every object has an up-to-date proxy and removes the proxies of objects which no longer exist. The proxy of a
+            /// continuous object covers the whole path it moved along so the trees find everything it may have passed through.
+            /// </summary>
+            void updateProxies (const std::vector<PhysicsObject*>& objects, const float delta);
+
+            /// <summary> Moves every non-static object by its velocity, this is a single non-virtual pass over the objects. </summary>
+            void integrate (const std::vector<PhysicsObject*>& objects, const float delta);
+
+            /// <summary> Removes every proxy in the given partition which wasn't seen during the current update. </summary>
+            void removeStaleProxies (Partition& partition);
+
+            /// <summary>
+            /// Runs tasks across the job system, or one after another without one, blocking until they've all completed. Each task is
+            /// given the index of the thread running it so it can use buffers of its own.
+            /// </summary>
+            void parallel (const unsigned int count, const std::function<void (const unsigned int task, const unsigned int thread)>& task);
+
+            /// <summary> Creates the tasks required to find every pair between two partitions, if there could be any. </summary>
+            void addTasks (const unsigned int partition, const unsigned int other, const unsigned int split);
+
+            /// <summary>
+            /// Finds every dynamic-dynamic and dynamic-static pair of objects on colliding layers which overlap. The trees provide
+            /// candidates whose fattened boxes overlap, these are grouped by object so each object can be tested against all of its
+            /// candidates at once. Both stages are split into tasks which are spread across the thread pool.
+            /// </summary>
+            void findPairs();
+
+            /// <summary>
+            /// Finds the candidates of a portion of the awake objects against a single tilemap. Objects are only candidates if they touch
+            /// a solid tile on a colliding layer, continuous objects are swept against each tile covered by the path they moved along.
+            /// </summary>
+            void findTileCandidates (const unsigned int task, const unsigned int chunks,
+                                     std::vector<std::pair<unsigned int, unsigned int>>& candidates) const;
+
+            /// <summary> Groups the candidates found by every thread by their lower index using a counting sort. </summary>
+            void groupCandidates();
+
+            /// <summary>
+            /// Pushes each non-static object out of the static objects it overlaps. Continuous objects are first moved back to their
+            /// earliest time of impact, then every penetration remaining is removed one static at a time using the minimum translation
+            /// vector, or the side the object entered from when its motion is known. Tilemaps are resolved one solid tile at a time.
+            /// The colliders and proxies are updated so queries reflect the resolved positions.
+            /// </summary>
+            void resolvePenetrations (const std::vector<PhysicsObject*>& objects, const float delta);
+
+            /// <summary> Updates the contact of an overlapping pair, calling the enter or stay events of both objects. </summary>
+            void updateContact (const std::vector<PhysicsObject*>& objects, const std::pair<unsigned int, unsigned int>& pair);
+
+            /// <summary> Removes every contact which wasn't seen during the current update, calling the exit events of both objects. </summary>
+            void removeStaleContacts();
+
+            /// <summary> Adds a contact to the batch of its handler, if the layers of its objects have one. </summary>
+            /// <param name="first"> The first object of the contact, nullptr if it no longer exists. </param>
+            /// <param name="second"> The second object of the contact, nullptr if it no longer exists. </param>
+            /// <returns> Whether a handler will be given the contact, if not the objects should be notified instead. </returns>
+            bool batchContact (const ContactEvent event, const Contact& contact, PhysicsObject* const first, PhysicsObject* const second);
+
+            /// <summary> Gives each handler the contacts batched for the given event. </summary>
+            void callHandlers (const ContactEvent event);
+
+            /// <summary>
+            /// Tracks how long each non-static object has been still and puts islands of touching objects to sleep once all of them
+            /// have been still for long enough. Sleeping objects which an awake object moved into are woken.
+            /// </summary>
+            void updateSleep (const std::vector<PhysicsObject*>& objects);
+
+            /// <summary> Finds the root of the island containing an object, compressing the path to it. </summary>
+            unsigned int findIsland (unsigned int index);
+
+            /// <summary>
+            /// Moves every projectile and sweeps it against the objects on colliding layers, then removes the projectiles which hit
+            /// something solid or expired. The projectiles are split into chunks which are spread across the job system, the hits of
+            /// each chunk are joined in order so they don't depend on the number of threads.
+            /// </summary>
+            void updateProjectiles (const float delta);
+
+            /// <summary>
+            /// Sweeps a single projectile along the path it moved, finding every object it touched. Boxes are grown by the radius of the
+            /// projectile, which treats their corners as square, and circles are tested exactly.
+            /// </summary>
+            /// <param name="index"> The projectile to sweep. </param>
+            /// <param name="found"> Filled with the collider index and hit of each object touched, sorted by time. </param>
+            /// <param name="tests"> Incremented for every collider or tile tested exactly. </param>
+            void sweepProjectile (const unsigned int index, std::vector<std::pair<unsigned int, ProjectileHit>>& found,
+                                  unsigned int& tests) const;
+
+            /// <summary> Updates the proxy of each contact whose objects were moved to a different partition this update. </summary>
+            void refreshContacts();
+
+            /// <summary> Checks whether an object was given to the current update, without accessing the object. </summary>
+            bool exists (const PhysicsObject* const object, const int proxy, const unsigned int partition) const;
+
+            /// <summary> Casts a ray through a single partition, only accepting hits which are closer than the given distance. </summary>
+            /// <returns> Whether a closer hit was found, if so the hit will be overwritten. </returns>
+            bool raycast (const Partition& partition, const Vector2<float>& origin, const Vector2<float>& normal, const float distance,
+                          RaycastHit& hit) const;
+
+
             ///////////////////////////
             /// Implementation data ///
             ///////////////////////////
 
-            std::vector<unsigned int>   m_layers    { };    //!< A collection of layer masks representing the layers each layer collides with.
+            std::vector<unsigned int>                                        m_layers         { };       //!< A collection of layer masks representing the layers each layer collides with.
+            std::vector<Partition>                                           m_partitions     { };       //!< The broadphase of each layer, static and dynamic objects are kept apart.
+            ColliderBuffer                                                   m_colliders      { };       //!< The collider of each object during the latest update, in the same order.
+            util::JobSystem*                                                 m_jobs           { };       //!< The threads used to find pairs, nullptr uses the calling thread.
+            std::vector<Task>                                                m_tasks          { };       //!< The traversal tasks of the current update.
+            std::vector<std::pair<int, int>>                                 m_split          { };       //!< The traversal of two partitions as it is being split into tasks.
+            std::vector<std::vector<std::pair<unsigned int, unsigned int>>>  m_candidates     { };       //!< The pairs whose fattened boxes overlap found by each thread, lower index first.
+            std::vector<unsigned int>                                        m_offsets        { };       //!< The end of the candidates of each object once grouped.
+            std::vector<unsigned int>                                        m_grouped        { };       //!< The second index of each candidate, grouped by the first index.
+            std::vector<std::vector<unsigned int>>                           m_hits           { };       //!< The candidates of an object which actually intersect it, per thread.
+            std::vector<std::vector<std::pair<unsigned int, unsigned int>>>  m_batches        { };       //!< The overlapping pairs found by each narrowphase task, in object order.
+            std::vector<std::pair<unsigned int, unsigned int>>               m_pairs          { };       //!< The overlapping pairs found each update.
+            ContactMap                                                       m_contacts       { };       //!< Every contact from the latest update, keyed by the objects in address order.
+            std::vector<Contact>                                             m_exits          { };       //!< The contacts which ended during the current update.
+            std::vector<Handler>                                             m_handlers       { };       //!< Every contact handler, removed handlers are reused.
+            std::vector<unsigned int>                                        m_routes         { };       //!< The handler of each pair of layers, empty until a handler is registered.
+            std::vector<std::pair<unsigned int, unsigned int>>               m_resolve        { };       //!< The non-static and static index of each pair to be resolved.
+            std::vector<PhysicsObject*>                                      m_transfers      { };       //!< The objects whose proxy moved to a different partition this update, sorted.
+            std::vector<unsigned int>                                        m_islands        { };       //!< The parent of each object in the island forest, roots are their own parent.
+            std::vector<unsigned int>                                        m_islandSteps    { };       //!< How long the stillest object of each island has been still for, indexed by root.
+            std::vector<unsigned int>                                        m_movers         { };       //!< The index of every awake non-static object.
+            std::vector<std::pair<unsigned int, const TilemapCollider*>>     m_tilemaps       { };       //!< The index and tilemap of every object with a tilemap.
+            std::vector<unsigned int>                                        m_tileLayers     { };       //!< The tile layers which collide with each layer.
+            std::vector<Rectangle<float>>                                    m_obstacles      { };       //!< The boxes of the statics or tiles an object is being resolved against.
+            ProjectilePool                                                   m_projectiles    { };       //!< Every projectile which is currently alive.
+            std::vector<ProjectileHit>                                       m_projectileHits { };       //!< The hits of the latest update, ordered by projectile.
+            std::vector<std::vector<ProjectileHit>>                          m_hitBatches     { };       //!< The hits found by each projectile task, in projectile order.
+            std::vector<unsigned int>                                        m_sweepTests     { };       //!< The exact tests performed by each projectile task.
+            std::vector<std::vector<std::pair<unsigned int, ProjectileHit>>> m_sweeps         { };       //!< The objects touched by the projectile being swept, per thread.
+            std::vector<std::vector<unsigned int>>                           m_targets        { };       //!< The non-empty partitions which each layer of projectile collides with.
+            ProjectileHandler                                                m_hitHandler     { };       //!< Given the hits of every update, may be empty.
+            PhysicsStats                                                     m_stats          { };       //!< The measurements of the latest update.
+            util::RingBuffer<PhysicsStats>                                   m_history        { };       //!< The measurements of recent updates, empty unless enabled.
+            bool                                                             m_stayEvents     { true };  //!< Whether stay events should be delivered.
+            bool                                                             m_integration    { false }; //!< Whether velocities should be integrated.
+            bool                                                             m_resolution     { false }; //!< Whether penetrations of static objects should be resolved.
+            unsigned int                                                     m_sleepSteps     { 0 };     //!< How many still updates are required before sleeping, zero disables sleeping.
+            float                                                            m_sleepTolerance { 0.f };   //!< How far an object may move while being considered still.
+            unsigned int                                                     m_awake          { 0 };     //!< The number of awake non-static objects.
+            unsigned int                                                     m_stamp          { 0 };     //!< Incremented every update, used to detect removed objects.
     };
 }
 
@@ -0,0 +1,169 @@
+#include "ProjectilePool.hpp"
+
+
+// STL headers.
+#include <utility>
+
+
+// Engine headers.
+#include <Utility/Maths.hpp>
+
+
+// Engine namespace.
+namespace water
+{
+    ////////////////////
+    /// Constructors ///
+    ////////////////////
+
+    ProjectilePool::ProjectilePool (ProjectilePool&& move)
+    {
+        *this = std::move (move);
+    }
+
+
+    ProjectilePool& ProjectilePool::operator= (ProjectilePool&& move)
+    {
+        if (this != &move)
+        {
+            m_x             = std::move (move.m_x);
+            m_y             = std::move (move.m_y);
+            m_velocityX     = std::move (move.m_velocityX);
+            m_velocityY     = std::move (move.m_velocityY);
+            m_moveX         = std::move (move.m_moveX);
+            m_moveY         = std::move (move.m_moveY);
+            m_radii         = std::move (move.m_radii);
+            m_lifetimes     = std::move (move.m_lifetimes);
+            m_layers        = std::move (move.m_layers);
+            m_ids           = std::move (move.m_ids);
+            m_persistent    = std::move (move.m_persistent);
+            m_marked        = std::move (move.m_marked);
+        }
+
+        return *this;
+    }
+
+
+    ///////////////////////
+    /// Data management ///
+    ///////////////////////
+
+    void ProjectilePool::clear()
+    {
+        m_x.clear();
+        m_y.clear();
+        m_velocityX.clear();
+        m_velocityY.clear();
+        m_moveX.clear();
+        m_moveY.clear();
+        m_radii.clear();
+        m_lifetimes.clear();
+        m_layers.clear();
+        m_ids.clear();
+        m_persistent.clear();
+        m_marked.clear();
+    }
+
+
+    void ProjectilePool::add (const Projectile& projectile)
+    {
+        m_x.push_back (projectile.position.x);
+        m_y.push_back (projectile.position.y);
+        m_velocityX.push_back (projectile.velocity.x);
+        m_velocityY.push_back (projectile.velocity.y);
+        m_moveX.push_back (0.f);
+        m_moveY.push_back (0.f);
+        m_radii.push_back (util::max (projectile.radius, 0.f));
+        m_lifetimes.push_back (projectile.lifetime);
+        m_layers.push_back (util::min (projectile.layer, 31U));
+        m_ids.push_back (projectile.id);
+        m_persistent.push_back (projectile.persistent ? 1 : 0);
+        m_marked.push_back (0);
+    }
+
+
+    void ProjectilePool::removeMarked()
+    {
+        // Compact every array in a single pass so the survivors keep their order, which keeps hits deterministic.
+        const auto count    = size();
+        auto       kept     = 0U;
+
+        for (auto i = 0U; i < count; ++i)
+        {
+            if (m_marked[i] != 0)
+            {
+                continue;
+            }
+
+            if (kept != i)
+            {
+                m_x[kept]           = m_x[i];
+                m_y[kept]           = m_y[i];
+                m_velocityX[kept]   = m_velocityX[i];
+                m_velocityY[kept]   = m_velocityY[i];
+                m_moveX[kept]       = m_moveX[i];
+                m_moveY[kept]       = m_moveY[i];
+                m_radii[kept]       = m_radii[i];
+                m_lifetimes[kept]   = m_lifetimes[i];
+                m_layers[kept]      = m_layers[i];
+                m_ids[kept]         = m_ids[i];
+                m_persistent[kept]  = m_persistent[i];
+                m_marked[kept]      = 0;
+            }
+
+            ++kept;
+        }
+
+        // Pre-condition: Something was removed.
+        if (kept == count)
+        {
+            return;
+        }
+
+        m_x.resize (kept);
+        m_y.resize (kept);
+        m_velocityX.resize (kept);
+        m_velocityY.resize (kept);
+        m_moveX.resize (kept);
+        m_moveY.resize (kept);
+        m_radii.resize (kept);
+        m_lifetimes.resize (kept);
+        m_layers.resize (kept);
+        m_ids.resize (kept);
+        m_persistent.resize (kept);
+        m_marked.resize (kept);
+    }
+
+
+    ////////////////
+    /// Movement ///
+    ////////////////
+
+    void ProjectilePool::integrate (const float delta)
+    {
+        const auto count = size();
+
+        // Each axis is a separate loop over flat arrays with no branches so the compiler can vectorise them.
+        for (auto i = 0U; i < count; ++i)
+        {
+            m_moveX[i]  = m_velocityX[i] * delta;
+            m_x[i]     += m_moveX[i];
+        }
+
+        for (auto i = 0U; i < count; ++i)
+        {
+            m_moveY[i]  = m_velocityY[i] * delta;
+            m_y[i]     += m_moveY[i];
+        }
+
+        // Projectiles which never expire are left alone, the rest are marked as soon as their lifetime runs out.
+        for (auto i = 0U; i < count; ++i)
+        {
+            if (m_lifetimes[i] > 0.f)
+            {
+                m_lifetimes[i] -= delta;
+                m_marked[i]    |= m_lifetimes[i] <= 0.f ? 1 : 0;
+            }
+        }
+    }
+}
@@ -0,0 +1,114 @@
+#if !defined WATER_PROJECTILE_POOL_INCLUDED
+#define WATER_PROJECTILE_POOL_INCLUDED
+
+
+// STL headers.
+#include <cstdint>
+#include <vector>
+
+
+// Engine headers.
+#include <Interfaces/IPhysics.hpp>
+
+
+// Engine namespace.
+namespace water
+{
+    /// <summary>
+    /// Contiguous structure-of-arrays storage for every projectile owned by the physics system. Projectiles are plain data so adding
+    /// and removing them never allocates once the pool has grown, and moving them is a handful of loops over flat arrays which the
+    /// compiler can vectorise. Removal is deferred so indices stay valid while the projectiles are being swept on multiple threads.
+    /// </summary>
+    class ProjectilePool final
+    {
+        public:
+
+            ///////////////////////////////////
+            /// Constructors and destructor ///
+            ///////////////////////////////////
+
+            ProjectilePool()                                        = default;
+            ProjectilePool (const ProjectilePool& copy)             = default;
+            ProjectilePool& operator= (const ProjectilePool& copy)  = default;
+            ~ProjectilePool()                                       = default;
+
+            ProjectilePool (ProjectilePool&& move);
+            ProjectilePool& operator= (ProjectilePool&& move);
+
+
+            ///////////////////////////
+            /// Getters and setters ///
+            ///////////////////////////
+
+            /// <summary> Obtains the number of projectiles in the pool, including those waiting to be removed. </summary>
+            unsigned int size() const                                       { return (unsigned int) m_ids.size(); }
+
+            /// <summary> Obtains the current position of a projectile. </summary>
+            Vector2<float> getPosition (const unsigned int index) const     { return { m_x[index], m_y[index] }; }
+
+            /// <summary> Obtains how far a projectile moved during the latest call to integrate(). </summary>
+            Vector2<float> getDisplacement (const unsigned int index) const { return { m_moveX[index], m_moveY[index] }; }
+
+            /// <summary> Obtains the radius of a projectile. </summary>
+            float getRadius (const unsigned int index) const                { return m_radii[index]; }
+
+            /// <summary> Obtains the layer of a projectile. </summary>
+            unsigned int getLayer (const unsigned int index) const          { return m_layers[index]; }
+
+            /// <summary> Obtains the ID the game gave a projectile. </summary>
+            unsigned int getID (const unsigned int index) const             { return m_ids[index]; }
+
+            /// <summary> Indicates whether a projectile passes through what it hits. </summary>
+            bool isPersistent (const unsigned int index) const              { return m_persistent[index] != 0; }
+
+
+            ///////////////////////
+            /// Data management ///
+            ///////////////////////
+
+            /// <summary> Removes every projectile, reserved memory is maintained. </summary>
+            void clear();
+
+            /// <summary> Adds a projectile to the end of the pool, its index will be the previous size of the pool. </summary>
+            void add (const Projectile& projectile);
+
+            /// <summary> Marks a projectile for removal, it keeps its index until removeMarked() is called. Safe to call concurrently. </summary>
+            void mark (const unsigned int index)                            { m_marked[index] = 1; }
+
+            /// <summary> Removes every marked projectile, the remaining projectiles keep their order. </summary>
+            void removeMarked();
+
+
+            ////////////////
+            /// Movement ///
+            ////////////////
+
+            /// <summary>
+            /// Moves every projectile by its velocity, remembering how far each moved so their paths can be swept. Projectiles whose
+            /// lifetime runs out are marked for removal, they still travel and hit things during this update.
+            /// </summary>
+            /// <param name="delta"> The length of the physics update in seconds. </param>
+            void integrate (const float delta);
+
+        private:
+
+            ///////////////////////////
+            /// Implementation data ///
+            ///////////////////////////
+
+            std::vector<float>          m_x             { };    //!< The horizontal position of each projectile.
+            std::vector<float>          m_y             { };    //!< The vertical position of each projectile.
+            std::vector<float>          m_velocityX     { };    //!< The horizontal velocity of each projectile.
+            std::vector<float>          m_velocityY     { };    //!< The vertical velocity of each projectile.
+            std::vector<float>          m_moveX         { };    //!< How far each projectile moved horizontally during the update.
+            std::vector<float>          m_moveY         { };    //!< How far each projectile moved vertically during the update.
+            std::vector<float>          m_radii         { };    //!< The radius of each projectile.
+            std::vector<float>          m_lifetimes     { };    //!< The remaining lifetime of each projectile, zero or less never expires.
+            std::vector<unsigned int>   m_layers        { };    //!< The layer of each projectile.
+            std::vector<unsigned int>   m_ids           { };    //!< The ID of each projectile.
+            std::vector<std::uint8_t>   m_persistent    { };    //!< Whether each projectile passes through what it hits.
+            std::vector<std::uint8_t>   m_marked        { };    //!< Whether each projectile is waiting to be removed.
+    };
+}
+
+#endif
@@ -0,0 +1,280 @@
+#include "RenderPipeline.hpp"
+
+
+// STL headers.
+#include <utility>
+
+
+// Engine headers.
+#include <Utility/Profiler.hpp>
+
+
+// Engine namespace.
+namespace water
+{
+    ///////////////////////////////////
+    /// Constructors and destructor ///
+    ///////////////////////////////////
+
+    RenderPipeline::RenderPipeline (IEngineRenderer& renderer)
+        : m_renderer (renderer)
+    {
+        m_thread = std::thread (&RenderPipeline::work, this);
+    }
+
+
+    RenderPipeline::~RenderPipeline()
+    {
+        {
+            std::lock_guard<std::mutex> lock { m_mutex };
+            m_stop = true;
+        }
+
+        m_start.notify_one();
+        m_thread.join();
+    }
+
+
+    //////////////////
+    /// Pipelining ///
+    //////////////////
+
+    bool RenderPipeline::present()
+    {
+        std::unique_lock<std::mutex> lock { m_mutex };
+        m_idle.wait (lock, [this] { return !m_busy; });
+
+        // The render thread is idle so the lists can be exchanged, the old list keeps its capacity for the next recording.
+        const auto result = m_result;
+
+        std::swap (m_recording, m_drawing);
+        m_recording.clear();
+        m_busy = true;
+
+        lock.unlock();
+        m_start.notify_one();
+
+        return result;
+    }
+
+
+    void RenderPipeline::finish()
+    {
+        std::unique_lock<std::mutex> lock { m_mutex };
+        m_idle.wait (lock, [this] { return !m_busy; });
+    }
+
+
+    ////////////////
+    /// Viewport ///
+    ////////////////
+
+    void RenderPipeline::setViewport (const Rectangle<float>& viewport)
+    {
+        auto command        = Command { };
+        command.type        = CommandType::SetViewport;
+        command.viewport    = viewport;
+
+        m_recording.push_back (command);
+    }
+
+
+    void RenderPipeline::translateViewportTo (const Vector2<float>& translateTo)
+    {
+        auto command    = Command { };
+        command.type    = CommandType::TranslateViewport;
+        command.point   = translateTo;
+
+        m_recording.push_back (command);
+    }
+
+
+    ///////////////////////
+    /// Data management ///
+    ///////////////////////
+
+    TextureID RenderPipeline::loadTexture (const std::string& fileLocation, const int cropRight, const int cropBottom)
+    {
+        finish();
+        return m_renderer.loadTexture (fileLocation, cropRight, cropBottom);
+    }
+
+
+    TextureID RenderPipeline::createBlankTexture (const Vector2<float>& dimensions)
+    {
+        finish();
+        return m_renderer.createBlankTexture (dimensions);
+    }
+
+
+    void RenderPipeline::cropTexture (const TextureID target, const int right, const int bottom)
+    {
+        finish();
+        m_renderer.cropTexture (target, right, bottom);
+    }
+
+
+    void RenderPipeline::setFrameDimensions (const TextureID target, const Point& dimensions)
+    {
+        finish();
+        m_renderer.setFrameDimensions (target, dimensions);
+    }
+
+
+    void RenderPipeline::removeTexture (const TextureID texture)
+    {
+        finish();
+        m_renderer.removeTexture (texture);
+    }
+
+
+    void RenderPipeline::clearTextureData()
+    {
+        finish();
+        m_renderer.clearTextureData();
+    }
+
+
+    /////////////////
+    /// Rendering ///
+    /////////////////
+
+    void RenderPipeline::setFilteringMode (const FilterMode mode)
+    {
+        auto command    = Command { };
+        command.type    = CommandType::SetFilteringMode;
+        command.filter  = mode;
+
+        m_recording.push_back (command);
+    }
+
+
+    void RenderPipeline::drawToScreen (const Vector2<float>& point, const TextureID id, const BlendType blend)
+    {
+        auto command    = Command { };
+        command.type    = CommandType::DrawToScreen;
+        command.point   = point;
+        command.source  = id;
+        command.blend   = blend;
+
+        m_recording.push_back (command);
+    }
+
+
+    void RenderPipeline::drawToScreen (const Vector2<float>& point, const TextureID id, const Point& frame, const BlendType blend)
+    {
+        auto command    = Command { };
+        command.type    = CommandType::DrawFrameToScreen;
+        command.point   = point;
+        command.source  = id;
+        command.frame   = frame;
+        command.blend   = blend;
+
+        m_recording.push_back (command);
+    }
+
+
+    void RenderPipeline::drawToTexture (const Vector2<float>& point, const TextureID source, const TextureID target, const BlendType blend)
+    {
+        auto command    = Command { };
+        command.type    = CommandType::DrawToTexture;
+        command.point   = point;
+        command.source  = source;
+        command.target  = target;
+        command.blend   = blend;
+
+        m_recording.push_back (command);
+    }
+
+
+    void RenderPipeline::drawToTexture (const Vector2<float>& point, const TextureID source, const TextureID target, const Point& frame,
+                                        const BlendType blend)
+    {
+        auto command    = Command { };
+        command.type    = CommandType::DrawFrameToTexture;
+        command.point   = point;
+        command.source  = source;
+        command.target  = target;
+        command.frame   = frame;
+        command.blend   = blend;
+
+        m_recording.push_back (command);
+    }
+
+
+    /////////////////////////
+    /// Internal workings ///
+    /////////////////////////
+
+    void RenderPipeline::work()
+    {
+        while (true)
+        {
+            // Sleep until a frame is presented, any frame already presented is drawn before stopping.
+            {
+                std::unique_lock<std::mutex> lock { m_mutex };
+                m_start.wait (lock, [this] { return m_busy || m_stop; });
+
+                if (!m_busy)
+                {
+                    return;
+                }
+            }
+
+            // The recording thread never touches the list being drawn whilst we're busy.
+            auto result = false;
+
+            {
+                WATER_PROFILE_ZONE ("Draw frame");
+                replay (m_drawing);
+                result = m_renderer.update();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock { m_mutex };
+                m_result    = result;
+                m_busy      = false;
+            }
+
+            m_idle.notify_all();
+        }
+    }
+
+
+    void RenderPipeline::replay (const std::vector<Command>& commands)
+    {
+        for (const auto& command : commands)
+        {
+            switch (command.type)
+            {
+                case CommandType::SetViewport:
+                    m_renderer.setViewport (command.viewport);
+                    break;
+
+                case CommandType::TranslateViewport:
+                    m_renderer.translateViewportTo (command.point);
+                    break;
+
+                case CommandType::SetFilteringMode:
+                    m_renderer.setFilteringMode (command.filter);
+                    break;
+
+                case CommandType::DrawToScreen:
+                    m_renderer.drawToScreen (command.point, command.source, command.blend);
+                    break;
+
+                case CommandType::DrawFrameToScreen:
+                    m_renderer.drawToScreen (command.point, command.source, command.frame, command.blend);
+                    break;
+
+                case CommandType::DrawToTexture:
+                    m_renderer.drawToTexture (command.point, command.source, command.target, command.blend);
+                    break;
+
+                case CommandType::DrawFrameToTexture:
+                    m_renderer.drawToTexture (command.point, command.source, command.target, command.frame, command.blend);
+                    break;
+            }
+        }
+    }
+}
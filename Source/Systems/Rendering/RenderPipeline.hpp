@@ -0,0 +1,180 @@
+#if !defined WATER_RENDER_PIPELINE_INCLUDED
+#define WATER_RENDER_PIPELINE_INCLUDED
+
+
+// STL headers.
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// Engine headers.
+#include <Misc/Rectangle.hpp>
+#include <Misc/Vector2.hpp>
+#include <Systems/IEngineRenderer.hpp>
+
+
+// Engine namespace.
+namespace water
+{
+    /// <summary>
+    /// Lets a frame be drawn on a dedicated render thread whilst the next frame is simulated. The pipeline stands in for the renderer
+    /// during GameWorld::render(), recording every draw, viewport and filtering call into a list which holds the positions, frames and
+    /// texture IDs by value. present() hands the list to the render thread, which replays it into the real renderer and updates it,
+    /// whilst the caller returns to simulate the next frame. Two lists are used so recording never touches the list being drawn.
+    ///
+    /// Loading, creating, cropping and removing textures can't be deferred, they wait for the render thread to go idle and are then
+    /// performed immediately. Textures must therefore not be removed whilst draws recorded during the same frame still refer to them.
+    ///
+    /// The renderer must support being driven from a thread other than the one which created it, currently only RendererNull does. The
+    /// engine warns and renders without a pipeline when pipelining is requested for any other renderer.
+    /// </summary>
+    class RenderPipeline final : public IRenderer
+    {
+        public:
+
+            ///////////////////////////////////
+            /// Constructors and destructor ///
+            ///////////////////////////////////
+
+            /// <summary> Starts the render thread. </summary>
+            /// <param name="renderer"> The renderer to draw with, it must outlive the pipeline and is only used by one thread at a time. </param>
+            RenderPipeline (IEngineRenderer& renderer);
+
+            /// <summary> Waits for the frame being drawn, if any, then stops the render thread. </summary>
+            ~RenderPipeline() override final;
+
+            RenderPipeline (const RenderPipeline& copy)             = delete;
+            RenderPipeline& operator= (const RenderPipeline& copy)  = delete;
+            RenderPipeline (RenderPipeline&& move)                  = delete;
+            RenderPipeline& operator= (RenderPipeline&& move)       = delete;
+
+
+            //////////////////
+            /// Pipelining ///
+            //////////////////
+
+            /// <summary>
+            /// Waits for the render thread to finish the previous frame, then hands it the calls recorded since the last call. This must
+            /// be called from the thread which records.
+            /// </summary>
+            /// <returns> The result of updating the renderer after the previous frame, true if there was no previous frame. </returns>
+            bool present();
+
+            /// <summary> Blocks until the render thread has finished drawing. </summary>
+            void finish();
+
+
+            ////////////////
+            /// Viewport ///
+            ////////////////
+
+            /// <summary> Records a change of viewport. </summary>
+            void setViewport (const Rectangle<float>& viewport) override final;
+
+            /// <summary> Records a translation of the viewport. </summary>
+            void translateViewportTo (const Vector2<float>& translateTo) override final;
+
+
+            ///////////////////////
+            /// Data management ///
+            ///////////////////////
+
+            /// <summary> Waits for the render thread to go idle then loads the texture. </summary>
+            TextureID loadTexture (const std::string& fileLocation, const int cropRight = 0, const int cropBottom = 0) override final;
+
+            /// <summary> Waits for the render thread to go idle then creates the texture. </summary>
+            TextureID createBlankTexture (const Vector2<float>& dimensions) override final;
+
+            /// <summary> Waits for the render thread to go idle then crops the texture. </summary>
+            void cropTexture (const TextureID target, const int right, const int bottom) override final;
+
+            /// <summary> Waits for the render thread to go idle then sets the frame dimensions of the texture. </summary>
+            void setFrameDimensions (const TextureID target, const Point& dimensions) override final;
+
+            /// <summary> Waits for the render thread to go idle then removes the texture. </summary>
+            void removeTexture (const TextureID texture) override final;
+
+            /// <summary> Waits for the render thread to go idle then removes every texture. </summary>
+            void clearTextureData() override final;
+
+
+            /////////////////
+            /// Rendering ///
+            /////////////////
+
+            /// <summary> Records a change of filtering mode. </summary>
+            void setFilteringMode (const FilterMode mode) override final;
+
+            /// <summary> Records a draw onto the screen. </summary>
+            void drawToScreen (const Vector2<float>& point, const TextureID id, const BlendType blend) override final;
+
+            /// <summary> Records a draw of a single frame onto the screen. </summary>
+            void drawToScreen (const Vector2<float>& point, const TextureID id, const Point& frame, const BlendType blend) override final;
+
+            /// <summary> Records a draw onto a texture. </summary>
+            void drawToTexture (const Vector2<float>& point, const TextureID source, const TextureID target, const BlendType blend) override final;
+
+            /// <summary> Records a draw of a single frame onto a texture. </summary>
+            void drawToTexture (const Vector2<float>& point, const TextureID source, const TextureID target, const Point& frame,
+                                const BlendType blend) override final;
+
+        private:
+
+            /// <summary> The recordable calls. </summary>
+            enum class CommandType : int
+            {
+                SetViewport         = 0,    //!< setViewport().
+                TranslateViewport   = 1,    //!< translateViewportTo().
+                SetFilteringMode    = 2,    //!< setFilteringMode().
+                DrawToScreen        = 3,    //!< drawToScreen() without a frame.
+                DrawFrameToScreen   = 4,    //!< drawToScreen() with a frame.
+                DrawToTexture       = 5,    //!< drawToTexture() without a frame.
+                DrawFrameToTexture  = 6     //!< drawToTexture() with a frame.
+            };
+
+
+            /// <summary> A single recorded call, only the members used by its type are meaningful. </summary>
+            struct Command final
+            {
+                CommandType         type        { };        //!< Which call was made.
+                Vector2<float>      point       { };        //!< The point drawn at or translated to.
+                Rectangle<float>    viewport    { };        //!< The viewport which was set.
+                TextureID           source      { 0 };      //!< The texture drawn.
+                TextureID           target      { 0 };      //!< The texture drawn onto.
+                Point               frame       { };        //!< The frame drawn.
+                BlendType           blend       { };        //!< The blending used.
+                FilterMode          filter      { };        //!< The filtering mode which was set.
+            };
+
+
+            /////////////////////////
+            /// Internal workings ///
+            /////////////////////////
+
+            /// <summary> The loop of the render thread, replaying and presenting each frame it's given. </summary>
+            void work();
+
+            /// <summary> Performs every recorded call of a frame on the renderer. </summary>
+            void replay (const std::vector<Command>& commands);
+
+
+            ///////////////////////////
+            /// Implementation data ///
+            ///////////////////////////
+
+            IEngineRenderer&        m_renderer;             //!< The renderer which frames are drawn with.
+            std::vector<Command>    m_recording { };        //!< The calls of the frame being recorded.
+            std::vector<Command>    m_drawing   { };        //!< The calls of the frame being drawn by the render thread.
+            std::mutex              m_mutex     { };        //!< Protects the state shared with the render thread.
+            std::condition_variable m_start     { };        //!< Wakes the render thread when a frame is presented or the pipeline stops.
+            std::condition_variable m_idle      { };        //!< Wakes the recording thread when a frame has been drawn.
+            bool                    m_busy      { false };  //!< Whether the render thread has a frame to draw.
+            bool                    m_result    { true };   //!< The result of updating the renderer after the latest frame.
+            bool                    m_stop      { false };  //!< Tells the render thread to exit.
+            std::thread             m_thread    { };        //!< The render thread, started last so everything else is ready.
+    };
+}
+
+#endif
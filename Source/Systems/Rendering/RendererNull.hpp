@@ -0,0 +1,79 @@
+#if !defined WATER_RENDERER_NULL_INCLUDED
+#define WATER_RENDERER_NULL_INCLUDED
+
+
+// Engine headers.
+#include <Systems/IEngineRenderer.hpp>
+
+
+// Engine namespace.
+namespace water
+{
+    /// <summary>
+    /// A renderer which draws nothing, for running without a display. Each loaded or created texture is given a unique ID so games can
+    /// still tell them apart, and updating always succeeds so the engine only stops when the game does.
+    /// </summary>
+    class RendererNull final : public IEngineRenderer
+    {
+        public:
+
+            ///////////////////////////////////
+            /// Constructors and destructor ///
+            ///////////////////////////////////
+
+            RendererNull()                                      = default;
+            RendererNull (RendererNull&& move)                  = default;
+            RendererNull& operator= (RendererNull&& move)       = default;
+
+            ~RendererNull() override final { }
+
+            RendererNull (const RendererNull& copy)             = delete;
+            RendererNull& operator= (const RendererNull& copy)  = delete;
+
+
+            /////////////////////////
+            /// System management ///
+            /////////////////////////
+
+            void initialise (const int, const int, const int, const int, const FilterMode) override final               { }
+            bool update() override final                                                                                { return true; }
+
+
+            ////////////////
+            /// Viewport ///
+            ////////////////
+
+            void setViewport (const Rectangle<float>&) override final                                                   { }
+            void translateViewportTo (const Vector2<float>&) override final                                             { }
+
+
+            ///////////////////////
+            /// Data management ///
+            ///////////////////////
+
+            TextureID loadTexture (const std::string&, const int, const int) override final                             { return m_nextID++; }
+            TextureID createBlankTexture (const Vector2<float>&) override final                                         { return m_nextID++; }
+            void cropTexture (const TextureID, const int, const int) override final                                     { }
+            void setFrameDimensions (const TextureID, const Point&) override final                                      { }
+            void removeTexture (const TextureID) override final                                                         { }
+            void clearTextureData() override final                                                                      { }
+
+
+            /////////////////
+            /// Rendering ///
+            /////////////////
+
+            void setFilteringMode (const FilterMode) override final                                                     { }
+            void drawToScreen (const Vector2<float>&, const TextureID, const BlendType) override final                  { }
+            void drawToScreen (const Vector2<float>&, const TextureID, const Point&, const BlendType) override final     { }
+            void drawToTexture (const Vector2<float>&, const TextureID, const TextureID, const BlendType) override final { }
+
+            void drawToTexture (const Vector2<float>&, const TextureID, const TextureID, const Point&, const BlendType) override final { }
+
+        private:
+
+            TextureID   m_nextID    { 0 };  //!< The ID given to the next texture, IDs are never reused.
+    };
+}
+
+#endif
@@ -0,0 +1,128 @@
+#include "TimeFixed.hpp"
+
+
+// STL headers.
+#include <stdexcept>
+
+
+// Engine headers.
+#include <Utility/Maths.hpp>
+
+
+// Engine namespace.
+namespace water
+{
+    /////////////////////////
+    /// System management ///
+    /////////////////////////
+
+    void TimeFixed::initialise (const unsigned int physicsFPS, const unsigned int updateFPS, const unsigned int)
+    {
+        // Pre-condition: Physics FPS is higher than 0.
+        if (physicsFPS == 0)
+        {
+            throw std::invalid_argument ("TimeFixed::initialise(), physics FPS value must be higher than zero.");
+        }
+
+        const real one = 1;
+
+        m_targetPhysics = one / physicsFPS;
+        m_targetUpdate  = updateFPS > 0 ? one / updateFPS : 0;
+        m_updateDelta   = 0;
+        m_elapsed       = 0;
+        m_previousFrame = std::chrono::steady_clock::now();
+    }
+
+
+    unsigned int TimeFixed::updatePhysics()
+    {
+        // The whole frame is a single physics update.
+        m_updateDelta   += m_targetPhysics;
+        m_elapsed       += m_targetPhysics * m_timescale;
+        m_currentDelta  = (float) (m_targetPhysics * m_timescale);
+
+        return 1;
+    }
+
+
+    bool TimeFixed::update()
+    {
+        // Without a target the update covers the frame.
+        if (m_targetUpdate == 0)
+        {
+            m_currentDelta = (float) (m_updateDelta * m_timescale);
+            return true;
+        }
+
+        m_currentDelta = (float) (m_targetUpdate * m_timescale);
+        return isUpdateDue();
+    }
+
+
+    void TimeFixed::endFrame()
+    {
+        const auto now  = std::chrono::steady_clock::now();
+        m_frameTime     += std::chrono::duration<real> (now - m_previousFrame).count();
+        m_previousFrame = now;
+        ++m_frames;
+
+        if (m_targetUpdate == 0)
+        {
+            m_updateDelta = 0;
+        }
+
+        else if (isUpdateDue())
+        {
+            m_updateDelta -= m_targetUpdate;
+        }
+    }
+
+
+    void TimeFixed::resetTime()
+    {
+        m_currentDelta  = 0;
+        m_updateDelta   = 0;
+        m_frames        = 0;
+        m_frameTime     = 0;
+        m_previousFrame = std::chrono::steady_clock::now();
+    }
+
+
+    bool TimeFixed::isUpdateDue() const
+    {
+        // Summing physics updates rarely lands exactly on the target so allow for rounding.
+        return m_updateDelta >= m_targetUpdate - m_targetPhysics * 1e-6;
+    }
+
+
+    ///////////////////////
+    /// Time management ///
+    ///////////////////////
+
+    void TimeFixed::setTimescale (const real timescale)
+    {
+        m_timescale = util::max (timescale, (real) 0);
+    }
+
+
+    ////////////////////
+    /// Frame pacing ///
+    ////////////////////
+
+    void TimeFixed::setFramePacing (const FramePacing pacing)
+    {
+        m_pacing = pacing;
+    }
+
+
+    FrameStats TimeFixed::getFrameStats() const
+    {
+        // The loop never sleeps so it's always busy.
+        auto stats          = FrameStats { };
+        stats.frames        = m_frames;
+        stats.averageFrame  = m_frames != 0 ? (float) (m_frameTime / m_frames) : 0.f;
+        stats.cpuUsage      = 1.f;
+
+        return stats;
+    }
+}
@@ -0,0 +1,123 @@
+#if !defined WATER_TIME_FIXED_INCLUDED
+#define WATER_TIME_FIXED_INCLUDED
+
+
+// STL headers.
+#include <chrono>
+
+
+// Engine headers.
+#include <Systems/IEngineTime.hpp>
+
+
+// Engine namespace.
+namespace water
+{
+    /// <summary>
+    /// A time keeping engine which ignores the clock, every frame advances the game by exactly one physics update. The engine therefore
+    /// runs as fast as the hardware allows and every run of a game is identical, which suits headless simulation and benchmarking.
+    /// Updates follow simulated time so an update FPS lower than the physics FPS still skips frames. The clock is only read to
+    /// report how long frames really take.
+    /// </summary>
+    class TimeFixed final : public IEngineTime
+    {
+        public:
+
+            ///////////////////////////////////
+            /// Constructors and destructor ///
+            ///////////////////////////////////
+
+            TimeFixed()                                     = default;
+            TimeFixed (TimeFixed&& move)                    = default;
+            TimeFixed& operator= (TimeFixed&& move)         = default;
+
+            ~TimeFixed() override final { }
+
+            TimeFixed (const TimeFixed& copy)               = delete;
+            TimeFixed& operator= (const TimeFixed& copy)    = delete;
+
+
+            /////////////////////////
+            /// System management ///
+            /////////////////////////
+
+            /// <summary> Initialise the time system, preparing it for usage. </summary>
+            /// <param name="physicsFPS"> How many physics updates make up a simulated second, each frame performs one. </param>
+            /// <param name="updateFPS"> The FPS other systems should update at in simulated time. 0 means every frame. </param>
+            /// <param name="minFPS"> Unused as frames never fall behind. </param>
+            void initialise (const unsigned int physicsFPS, const unsigned int updateFPS, const unsigned int minFPS) override final;
+
+            /// <summary> Causes physics update to become the active context and advances simulated time by one physics update. </summary>
+            /// <returns> Always one. </returns>
+            unsigned int updatePhysics() override final;
+
+            /// <summary> Causes update to become the active context and updates the standard delta time. </summary>
+            bool update() override final;
+
+            /// <summary> Consumes the update which was performed this frame, if any. </summary>
+            void endFrame() override final;
+
+            /// <summary> Discards any partially elapsed update, this does not reset the simulated time since the start. </summary>
+            void resetTime() override final;
+
+
+            ///////////////////////
+            /// Time management ///
+            ///////////////////////
+
+            /// <summary> Get the delta time value of the current update loop in seconds. </summary>
+            /// <returns> The physics update time during updatePhysics() or the update time during update(). </returns>
+            float getDelta() const override final           { return m_currentDelta; }
+
+            /// <summary> Always zero as rendering happens exactly on a physics update. </summary>
+            float getPhysicsStep() const override final     { return 0.f; }
+
+            /// <summary> Obtains the simulated time in seconds since the game start. </summary>
+            float timeSinceStart() const override final     { return (float) m_elapsed; }
+
+            /// <summary> Obtains the time scale currently being applied each frame. </summary>
+            float timescale() const override final          { return (float) m_timescale; }
+
+            /// <summary> This sets the time scale applied to the simulated frame times. This will not go below zero. </summary>
+            void setTimescale (const real timescale) override final;
+
+
+            ////////////////////
+            /// Frame pacing ///
+            ////////////////////
+
+            /// <summary> Obtains the pacing policy which was set, it's ignored as frames never wait. </summary>
+            FramePacing getFramePacing() const override final   { return m_pacing; }
+
+            /// <summary> Stores the pacing policy, it's ignored as frames never wait. </summary>
+            void setFramePacing (const FramePacing pacing) override final;
+
+            /// <summary> Obtains the number and real average length of frames since the last reset, frames never wait. </summary>
+            FrameStats getFrameStats() const override final;
+
+        private:
+
+            /// <summary> Checks whether enough simulated time has passed for an update. </summary>
+            bool isUpdateDue() const;
+
+
+            ///////////////////////////
+            /// Implementation data ///
+            ///////////////////////////
+
+            real                                    m_targetPhysics { 0 },                  //!< The simulated length of each frame.
+                                                    m_targetUpdate  { 0 },                  //!< The simulated time between updates, zero updates every frame.
+                                                    m_timescale     { 1 },                  //!< The scale applied to time values, this can create slow motion in the game.
+                                                    m_updateDelta   { 0 },                  //!< The update delta accumulator.
+                                                    m_elapsed       { 0 };                  //!< The simulated time since the start of the game.
+            float                                   m_currentDelta  { 0 };                  //!< The current delta time value.
+
+            FramePacing                             m_pacing        { FramePacing::Spin };  //!< The pacing policy which was set.
+            unsigned int                            m_frames        { 0 };                  //!< How many frames have ended since the reset.
+            real                                    m_frameTime     { 0 };                  //!< The total real time taken by every frame since the reset.
+
+            std::chrono::steady_clock::time_point   m_previousFrame { };                    //!< When the previous frame really ended.
+    };
+}
+
+#endif
@@ -2,7 +2,9 @@
 
 
 // STL headers.
+#include <cmath>
 #include <stdexcept>
+#include <thread>
 
 
 // Engine headers.
@@ -35,10 +37,21 @@ namespace water
             m_updateDelta       = move.m_updateDelta;
             m_currentDelta      = move.m_currentDelta;
             m_physicsStep       = move.m_physicsStep;
+            m_maxSteps          = move.m_maxSteps;
 
             m_startTime         = std::move (move.m_startTime);
             m_previousPhysics   = std::move (move.m_previousPhysics);
             m_previousUpdate    = std::move (move.m_previousUpdate);
+            m_previousFrame     = std::move (move.m_previousFrame);
+
+            m_pacing            = move.m_pacing;
+            m_slack             = move.m_slack;
+            m_frameTime         = move.m_frameTime;
+            m_sleepTime         = move.m_sleepTime;
+            m_jitterTime        = move.m_jitterTime;
+            m_maxJitter         = move.m_maxJitter;
+            m_frames            = move.m_frames;
+            m_waits             = move.m_waits;
 
             // Reset primitives.
             move.m_targetPhysics    = 0;
@@ -50,6 +63,14 @@ namespace water
             move.m_updateDelta      = 0;
             move.m_currentDelta     = 0;
             move.m_physicsStep      = 0;
+            move.m_maxSteps         = 1;
+
+            move.m_frameTime        = 0;
+            move.m_sleepTime        = 0;
+            move.m_jitterTime       = 0;
+            move.m_maxJitter        = 0;
+            move.m_frames           = 0;
+            move.m_waits            = 0;
         }
 
         return *this;
@@ -80,28 +101,32 @@ namespace water
         m_targetPhysics = one / physicsFPS;
         m_targetUpdate = updateFPS > 0 ? one / updateFPS : 0;
         m_maxDelta = one / minFPS;
+        m_maxSteps = physicsFPS / minFPS;
 
         // Obtain the beautiful current time point.
         const auto& now = high_resolution_clock::now();
         m_startTime = now;
         m_previousPhysics = now;
         m_previousUpdate = now;
+        m_previousFrame = now;
     }
 
 
-    bool TimeSTL::updatePhysics()
+    unsigned int TimeSTL::updatePhysics()
     {
         // Obtain the current point in time and use it to calculate the delta time.
         const auto& now = high_resolution_clock::now();
         const auto time = duration<real> (now - m_previousPhysics).count();
 
-        // Set the physics delta and checks if a physics update should be performed.
         m_physicsDelta += time;
         m_previousPhysics = now;
-        m_physicsStep = (float) util::max (m_physicsDelta / m_targetPhysics, 1.0);
         setCurrentDelta (m_targetPhysics);
 
-        return m_physicsDelta >= m_targetPhysics;
+        // Every elapsed update is due but only so many can be performed, the remainder is how far we are towards the next update.
+        const auto due = std::floor (m_physicsDelta / m_targetPhysics);
+        m_physicsStep = (float) ((m_physicsDelta - due * m_targetPhysics) / m_targetPhysics);
+
+        return (unsigned int) util::min (due, (real) m_maxSteps);
     }
 
 
@@ -139,16 +164,8 @@ namespace water
 
     void TimeSTL::endFrame()
     {
-        // Decrement the physics delta.
-        if (m_physicsDelta > m_maxDelta)
-        {
-            m_physicsDelta = 0;
-        }
-
-        else if (m_physicsDelta >= m_targetPhysics)
-        {
-            m_physicsDelta -= m_targetPhysics;
-        }
+        // Consume every update which was due, including any which were dropped because there were too many.
+        m_physicsDelta = std::fmod (m_physicsDelta, m_targetPhysics);
 
         // Decrement the update delta.
         if (m_updateDelta > m_maxDelta)
@@ -168,6 +185,14 @@ namespace water
         {
             m_updateDelta = 0;
         }
+
+        // Wait for the next frame which has something to do then measure how long this one took in total.
+        pace();
+
+        const auto& now = high_resolution_clock::now();
+        m_frameTime += duration<real> (now - m_previousFrame).count();
+        m_previousFrame = now;
+        ++m_frames;
     }
 
 
@@ -178,6 +203,14 @@ namespace water
         m_updateDelta = 0;
         m_previousPhysics = high_resolution_clock::now();
         m_previousUpdate = high_resolution_clock::now();
+        m_previousFrame = m_previousUpdate;
+
+        m_frameTime = 0;
+        m_sleepTime = 0;
+        m_jitterTime = 0;
+        m_maxJitter = 0;
+        m_frames = 0;
+        m_waits = 0;
     }
 
 
@@ -187,6 +220,80 @@ namespace water
     }
 
 
+    high_resolution_clock::time_point TimeSTL::nextDeadline() const
+    {
+        // The accumulators hold real time since the previous time points, before the timescale is applied.
+        const auto physics = m_previousPhysics + duration_cast<high_resolution_clock::duration> (duration<real> (m_targetPhysics - m_physicsDelta));
+
+        if (m_targetUpdate == 0)
+        {
+            return physics;
+        }
+
+        const auto update = m_previousUpdate + duration_cast<high_resolution_clock::duration> (duration<real> (m_targetUpdate - m_updateDelta));
+
+        return physics < update ? physics : update;
+    }
+
+
+    void TimeSTL::pace()
+    {
+        if (m_pacing == FramePacing::Spin)
+        {
+            return;
+        }
+
+        const auto deadline = nextDeadline();
+        auto now            = high_resolution_clock::now();
+
+        // We may already be late.
+        if (now >= deadline)
+        {
+            return;
+        }
+
+        // Adaptive pacing wakes early enough to absorb the worst recent oversleep.
+        if (m_pacing == FramePacing::Sleep || m_pacing == FramePacing::Adaptive)
+        {
+            const auto wake = m_pacing == FramePacing::Sleep ?
+                deadline : deadline - duration_cast<high_resolution_clock::duration> (duration<real> (m_slack));
+
+            if (wake > now)
+            {
+                std::this_thread::sleep_until (wake);
+
+                const auto woke = high_resolution_clock::now();
+                m_sleepTime += duration<real> (woke - now).count();
+                now = woke;
+
+                // Slowly forget the worst oversleep so a single stall doesn't waste a core forever. The slack never grows past half a
+                // physics update so we can't wake after a deadline has passed without yielding.
+                if (m_pacing == FramePacing::Adaptive)
+                {
+                    const auto oversleep = duration<real> (woke - wake).count();
+                    m_slack = util::clamp (util::max (oversleep * 1.5, m_slack * 0.99), 0.0002, m_targetPhysics * 0.5);
+                }
+            }
+        }
+
+        // Give up the rest of the time slice until the deadline, this is far more precise than sleeping.
+        if (m_pacing != FramePacing::Sleep)
+        {
+            while (now < deadline)
+            {
+                std::this_thread::yield();
+                now = high_resolution_clock::now();
+            }
+        }
+
+        const auto jitter = std::abs (duration<real> (now - deadline).count());
+
+        m_jitterTime += jitter;
+        m_maxJitter = util::max (m_maxJitter, jitter);
+        ++m_waits;
+    }
+
+
     ///////////////////////
     /// Time management ///
     ///////////////////////
@@ -204,4 +311,29 @@ namespace water
     {
         m_timescale = util::max (timescale, (real) 0);
     }
+
+
+    ////////////////////
+    /// Frame pacing ///
+    ////////////////////
+
+    void TimeSTL::setFramePacing (const FramePacing pacing)
+    {
+        m_pacing = pacing;
+    }
+
+
+    FrameStats TimeSTL::getFrameStats() const
+    {
+        auto stats          = FrameStats { };
+        stats.frames        = m_frames;
+        stats.waits         = m_waits;
+        stats.averageFrame  = m_frames != 0 ? (float) (m_frameTime / m_frames) : 0.f;
+        stats.averageJitter = m_waits != 0 ? (float) (m_jitterTime / m_waits) : 0.f;
+        stats.maxJitter     = (float) m_maxJitter;
+        stats.cpuUsage      = m_frameTime > 0 ? (float) (1 - m_sleepTime / m_frameTime) : 1.f;
+        stats.slack         = (float) m_slack;
+
+        return stats;
+    }
 }
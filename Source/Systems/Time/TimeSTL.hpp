@@ -18,7 +18,9 @@ using namespace std::chrono;
 namespace water
 {
     /// <summary>
-    /// A time keeping engine which uses the chrono library to track time.
+    /// A time keeping engine which uses the chrono library to track time. Once a frame ends the engine waits until the next physics
+    /// update or update is due, according to the frame pacing policy, so the game loop doesn't occupy a whole core rendering frames
+    /// which show nothing new. An unlimited update FPS is paced by physics alone.
     /// </summary>
     class TimeSTL final : public IEngineTime
     {
@@ -49,16 +51,21 @@ namespace water
             /// <returns> Whether the initialisation was successful. </returns>
             void initialise (const unsigned int physicsFPS, const unsigned int updateFPS, const unsigned int minFPS) override final;
 
-            /// <summary> Causes physics update to become the active context and updates the physics delta time. </summary>
-            bool updatePhysics() override final;
+            /// <summary>
+            /// Causes physics update to become the active context and updates the physics delta time. Every fixed update which has
+            /// elapsed is due, up to as many as fit in a frame at the minimum FPS. Time beyond that is dropped so the game slows
+            /// down rather than falling further behind.
+            /// </summary>
+            /// <returns> How many fixed physics updates should be performed this frame. </returns>
+            unsigned int updatePhysics() override final;
 
             /// <summary> Causes update to become the active context and updates the standard delta time. </summary>
             bool update() override final;
 
-            /// <summary> Causes the time system to perform end-of-frame actions such as decrementing accumulators. </summary>
+            /// <summary> Causes the time system to perform end-of-frame actions such as decrementing accumulators, then waits for the next deadline. </summary>
             void endFrame() override final;
 
-            /// <summary> Force the time class to reset the time values, this does not reset the start time of the application. </summary>
+            /// <summary> Force the time class to reset the time values and frame statistics, this does not reset the start time of the application. </summary>
             void resetTime() override final;
 
 
@@ -70,7 +77,10 @@ namespace water
             /// <returns> The physics update time during updatePhysics() or the update time during update(). </returns>
             float getDelta() const override final           { return m_currentDelta; }
 
-            /// <summary> Obtains a normalised value of the current point in time between the previous physics update and the next physics update. </summary>
+            /// <summary>
+            /// Obtains a normalised value of the current point in time between the previous physics update and the next physics update,
+            /// once the updates due this frame have been performed. This is the interpolation factor for rendering between physics states.
+            /// </summary>
             float getPhysicsStep() const override final     { return m_physicsStep; }
 
             /// <summary> Obtains the time in seconds since the game start. </summary>
@@ -82,11 +92,31 @@ namespace water
             /// <summary> This sets the time scale applied to the real world frame times. This will not go below zero. </summary>
             void setTimescale (const real timescale) override final;
 
+
+            ////////////////////
+            /// Frame pacing ///
+            ////////////////////
+
+            /// <summary> Obtains how the end of each frame waits for the next deadline. </summary>
+            FramePacing getFramePacing() const override final   { return m_pacing; }
+
+            /// <summary> Changes how the end of each frame waits for the next deadline. </summary>
+            void setFramePacing (const FramePacing pacing) override final;
+
+            /// <summary> Obtains measurements of frame pacing since the last reset. </summary>
+            FrameStats getFrameStats() const override final;
+
         private:
 
             /// <summary> Sets the current delta value, applying the timescale value. </summary>
             void setCurrentDelta (const real delta);
 
+            /// <summary> Obtains the point in time when the next physics update or update becomes due. </summary>
+            high_resolution_clock::time_point nextDeadline() const;
+
+            /// <summary> Waits until the next deadline according to the pacing policy, measuring how accurately it did so. </summary>
+            void pace();
+
 
             ///////////////////////////
             /// Implementation data ///
@@ -101,10 +131,21 @@ namespace water
                                                 m_updateDelta       { 0 };  //!< The update delta accumulator.
             float                               m_currentDelta      { 0 },  //!< The current delta time value.
                                                 m_physicsStep       { 0 };  //!< The step value for the current point between the previous physics update and the next.
+            unsigned int                        m_maxSteps          { 1 };  //!< The most physics updates which may be performed in a single frame.
 
             high_resolution_clock::time_point   m_startTime         { },    //!< The initial time point since the start of the application.
                                                 m_previousPhysics   { },    //!< The previous physics time point.
-                                                m_previousUpdate    { };    //!< The previous update time point.
+                                                m_previousUpdate    { },    //!< The previous update time point.
+                                                m_previousFrame     { };    //!< When the previous frame ended.
+
+            FramePacing                         m_pacing            { FramePacing::Adaptive };  //!< How the end of each frame waits.
+            real                                m_slack             { 0.001 },                  //!< How early adaptive pacing wakes before a deadline.
+                                                m_frameTime         { 0 },                      //!< The total time taken by every frame since the reset.
+                                                m_sleepTime         { 0 },                      //!< The total time spent asleep since the reset.
+                                                m_jitterTime        { 0 },                      //!< The total time waits ended away from their deadline.
+                                                m_maxJitter         { 0 };                      //!< The furthest a wait has ended away from its deadline.
+            unsigned int                        m_frames            { 0 },                      //!< How many frames have ended since the reset.
+                                                m_waits             { 0 };                      //!< How many frames waited since the reset.
     };
 }
 
@@ -0,0 +1,291 @@
+#include "JobSystem.hpp"
+
+
+// STL headers.
+#include <utility>
+
+
+// Utility namespace.
+namespace util
+{
+    // The system and index of the calling thread, only set on worker threads.
+    static thread_local const JobSystem*    t_system    { nullptr };
+    static thread_local unsigned int        t_index     { 0 };
+
+
+    ///////////////////////////////////
+    /// Constructors and destructor ///
+    ///////////////////////////////////
+
+    JobSystem::JobSystem (const unsigned int threads)
+    {
+        // The hardware may not be able to tell us how many threads it supports.
+        auto total = threads != 0 ? threads : std::thread::hardware_concurrency();
+
+        if (total == 0)
+        {
+            total = 1;
+        }
+
+        // Every deque must exist before any worker starts stealing.
+        m_queues.reserve (total);
+
+        for (auto i = 0U; i < total; ++i)
+        {
+            m_queues.emplace_back (new Queue());
+        }
+
+        // The creator is the first thread so only the rest need creating.
+        m_workers.reserve (total - 1);
+
+        for (auto i = 1U; i < total; ++i)
+        {
+            m_workers.emplace_back (&JobSystem::work, this, i);
+        }
+    }
+
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard<std::mutex> lock { m_mutex };
+            m_stop = true;
+        }
+
+        m_wake.notify_all();
+
+        for (auto& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+
+    ///////////////////////////
+    /// Getters and setters ///
+    ///////////////////////////
+
+    unsigned int JobSystem::getThreadIndex() const
+    {
+        return t_system == this ? t_index : 0;
+    }
+
+
+    ///////////////
+    /// Running ///
+    ///////////////
+
+    void JobSystem::run (const std::function<void()>& job, JobCounter* const counter)
+    {
+        if (counter)
+        {
+            counter->m_value.fetch_add (1, std::memory_order_relaxed);
+        }
+
+        push ({ job, counter });
+    }
+
+
+    void JobSystem::run (const std::function<void()>& job, JobCounter* const counter, JobCounter& dependency)
+    {
+        if (counter)
+        {
+            counter->m_value.fetch_add (1, std::memory_order_relaxed);
+        }
+
+        // The dependency only reaches zero whilst its lock is held, so the job is either released by it or scheduled by us.
+        {
+            std::lock_guard<std::mutex> lock { dependency.m_mutex };
+
+            if (dependency.m_value.load (std::memory_order_acquire) != 0)
+            {
+                dependency.m_waiting.push_back ({ job, counter });
+                return;
+            }
+        }
+
+        push ({ job, counter });
+    }
+
+
+    void JobSystem::wait (const JobCounter& counter)
+    {
+        const auto thread = getThreadIndex();
+
+        while (!counter.isComplete())
+        {
+            if (!runOne (thread))
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        // The thread which completed the last job may still be releasing its dependents, it's finished once the lock is free.
+        std::lock_guard<std::mutex> lock { counter.m_mutex };
+
+        if (counter.m_error)
+        {
+            std::rethrow_exception (counter.m_error);
+        }
+    }
+
+
+    void JobSystem::parallelFor (const unsigned int count, const unsigned int grain, const Range& range)
+    {
+        // Each thread gets a few jobs so uneven ranges are balanced by stealing.
+        const auto size = grain != 0 ? grain : count / (getThreadCount() * 4) + 1;
+
+        // Avoid the cost of scheduling if there's only a single job.
+        if (count <= size)
+        {
+            if (count != 0)
+            {
+                range (0, count);
+            }
+
+            return;
+        }
+
+        JobCounter counter { };
+
+        for (auto begin = 0U; begin < count; begin += size)
+        {
+            const auto end = count - begin > size ? begin + size : count;
+
+            run ([&range, begin, end] () { range (begin, end); }, &counter);
+        }
+
+        wait (counter);
+    }
+
+
+    /////////////////////////
+    /// Internal workings ///
+    /////////////////////////
+
+    void JobSystem::push (Job&& job)
+    {
+        // Counting first means the count never drops below the number of jobs waiting, a worker which checks it too early just looks again.
+        m_queued.fetch_add (1, std::memory_order_release);
+
+        {
+            auto& queue = *m_queues[getThreadIndex()];
+            std::lock_guard<std::mutex> lock { queue.mutex };
+            queue.jobs.push_back (std::move (job));
+        }
+
+        // Taking the lock means a worker can't check the count and then sleep through the notification.
+        {
+            std::lock_guard<std::mutex> lock { m_mutex };
+        }
+
+        m_wake.notify_one();
+    }
+
+
+    bool JobSystem::runOne (const unsigned int thread)
+    {
+        auto job    = Job { };
+        auto found  = false;
+
+        // Our own newest job is most likely to still be in the cache.
+        {
+            auto& queue = *m_queues[thread];
+            std::lock_guard<std::mutex> lock { queue.mutex };
+
+            if (!queue.jobs.empty())
+            {
+                job = std::move (queue.jobs.back());
+                queue.jobs.pop_back();
+                found = true;
+            }
+        }
+
+        // Steal the oldest job of another thread, starting with our neighbour so thieves spread out.
+        const auto count = getThreadCount();
+
+        for (auto i = 1U; !found && i < count; ++i)
+        {
+            auto& queue = *m_queues[(thread + i) % count];
+            std::lock_guard<std::mutex> lock { queue.mutex };
+
+            if (!queue.jobs.empty())
+            {
+                job = std::move (queue.jobs.front());
+                queue.jobs.pop_front();
+                found = true;
+            }
+        }
+
+        if (found)
+        {
+            m_queued.fetch_sub (1, std::memory_order_relaxed);
+            execute (job);
+        }
+
+        return found;
+    }
+
+
+    void JobSystem::execute (Job& job)
+    {
+        // A job which throws must still complete, otherwise its waiters and dependents would never run.
+        auto error = std::exception_ptr { };
+
+        try
+        {
+            job.function();
+        }
+
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        const auto counter = job.counter;
+
+        if (!counter)
+        {
+            return;
+        }
+
+        // Jobs waiting on the counter are taken whilst it reaches zero, after which the counter must not be touched.
+        auto released = std::vector<Job> { };
+
+        {
+            std::lock_guard<std::mutex> lock { counter->m_mutex };
+
+            if (error && !counter->m_error)
+            {
+                counter->m_error = error;
+            }
+
+            if (counter->m_value.fetch_sub (1, std::memory_order_acq_rel) == 1)
+            {
+                released.swap (counter->m_waiting);
+            }
+        }
+
+        for (auto& waiting : released)
+        {
+            push (std::move (waiting));
+        }
+    }
+
+
+    void JobSystem::work (const unsigned int thread)
+    {
+        t_system    = this;
+        t_index     = thread;
+
+        while (!m_stop.load (std::memory_order_acquire))
+        {
+            if (!runOne (thread))
+            {
+                // Sleep until there's something to take or the system is being destroyed.
+                std::unique_lock<std::mutex> lock { m_mutex };
+                m_wake.wait (lock, [this] { return m_stop.load() || m_queued.load (std::memory_order_acquire) != 0; });
+            }
+        }
+    }
+}
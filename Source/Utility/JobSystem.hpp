@@ -0,0 +1,176 @@
+#if !defined WATER_UTILITY_JOB_SYSTEM_INCLUDED
+#define WATER_UTILITY_JOB_SYSTEM_INCLUDED
+
+
+// STL headers.
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// Utility namespace.
+namespace util
+{
+    // Forward declarations.
+    class JobSystem;
+
+
+    /// <summary>
+    /// Counts the unfinished jobs of a group. A counter is incremented when a job is given to it and decremented when the job completes,
+    /// so waiting on it waits for the whole group. Jobs can also be held back until a counter reaches zero, which is how dependencies
+    /// between groups are expressed. A counter must outlive every job given to it or waiting on it, waiting on a counter before destroying
+    /// it guarantees this. If a job throws, the counter still completes and keeps the first exception so waiting on it rethrows.
+    /// </summary>
+    class JobCounter final
+    {
+        public:
+
+            JobCounter()                                    = default;
+            JobCounter (const JobCounter& copy)             = delete;
+            JobCounter& operator= (const JobCounter& copy)  = delete;
+
+            /// <summary> Indicates whether every job given to the counter has completed. </summary>
+            bool isComplete() const                         { return m_value.load (std::memory_order_acquire) == 0; }
+
+        private:
+
+            // Let JobSystem manage the count and the jobs waiting on it.
+            friend class JobSystem;
+
+            /// <summary> A job and the counter to decrement when it completes. </summary>
+            struct Job final
+            {
+                std::function<void()>   function    { };            //!< The work to perform.
+                JobCounter*             counter     { nullptr };    //!< Decremented once the function returns, may be nullptr.
+            };
+
+            std::atomic<unsigned int>   m_value     { 0 };      //!< The number of jobs which haven't completed.
+            mutable std::mutex          m_mutex     { };        //!< Protects the waiting jobs and the error, held whilst the counter reaches zero.
+            std::vector<Job>            m_waiting   { };        //!< The jobs which start once the counter reaches zero.
+            std::exception_ptr          m_error     { };        //!< The first exception thrown by a job given to the counter.
+    };
+
+
+    /// <summary>
+    /// A work-stealing scheduler for short, independent jobs. Each thread has its own deque of jobs; a thread takes the newest job from
+    /// its own deque and, once it's empty, steals the oldest job from another thread. Threads which wait on a counter run jobs while
+    /// they wait, so jobs may wait on other jobs without deadlocking. The thread which creates the system is the first thread, jobs
+    /// given by threads outside of the system are added to its deque.
+    /// </summary>
+    class JobSystem final
+    {
+        public:
+
+            /// <summary> The function type of a parallel loop, given the range of indices to process. </summary>
+            using Range = std::function<void (const unsigned int begin, const unsigned int end)>;
+
+
+            ///////////////////////////////////
+            /// Constructors and destructor ///
+            ///////////////////////////////////
+
+            /// <summary> Creates the system, starting its worker threads. </summary>
+            /// <param name="threads"> The total number of threads including the creator, zero will use every hardware thread. </param>
+            JobSystem (const unsigned int threads = 0);
+
+            /// <summary> Stops and joins every worker thread, jobs which haven't started are discarded. </summary>
+            ~JobSystem();
+
+            JobSystem (const JobSystem& copy)               = delete;
+            JobSystem& operator= (const JobSystem& copy)    = delete;
+            JobSystem (JobSystem&& move)                    = delete;
+            JobSystem& operator= (JobSystem&& move)         = delete;
+
+
+            ///////////////////////////
+            /// Getters and setters ///
+            ///////////////////////////
+
+            /// <summary> Obtains the total number of threads which run jobs, including the creator of the system. </summary>
+            unsigned int getThreadCount() const             { return (unsigned int) m_queues.size(); }
+
+            /// <summary> Obtains the index of the calling thread, zero for the creator and for threads outside of the system. </summary>
+            unsigned int getThreadIndex() const;
+
+
+            ///////////////
+            /// Running ///
+            ///////////////
+
+            /// <summary> Schedules a job to run on any thread. </summary>
+            /// <param name="job"> The work to perform. </param>
+            /// <param name="counter"> Incremented now and decremented once the job completes, may be nullptr. </param>
+            void run (const std::function<void()>& job, JobCounter* const counter = nullptr);
+
+            /// <summary> Schedules a job to run once every job given to another counter has completed. </summary>
+            /// <param name="job"> The work to perform. </param>
+            /// <param name="counter"> Incremented now and decremented once the job completes, may be nullptr. </param>
+            /// <param name="dependency"> The job won't start until this reaches zero, if it already has the job is scheduled immediately. </param>
+            void run (const std::function<void()>& job, JobCounter* const counter, JobCounter& dependency);
+
+            /// <summary> Blocks until a counter reaches zero, running jobs in the meantime, then rethrows the first exception of its jobs. </summary>
+            void wait (const JobCounter& counter);
+
+            /// <summary>
+            /// Splits a loop into jobs and blocks until every index has been processed, running jobs in the meantime. If any range throws
+            /// the rest still run and the first exception is rethrown.
+            /// </summary>
+            /// <param name="count"> The number of indices to process. </param>
+            /// <param name="grain"> The most indices a single job processes, zero picks a size which gives each thread a few jobs. </param>
+            /// <param name="range"> The function to call with each range of indices. </param>
+            void parallelFor (const unsigned int count, const unsigned int grain, const Range& range);
+
+        private:
+
+            using Job = JobCounter::Job;
+
+
+            /// <summary> The jobs of a single thread, the owner uses the back and thieves use the front. </summary>
+            struct Queue final
+            {
+                std::mutex      mutex   { };    //!< Protects the jobs.
+                std::deque<Job> jobs    { };    //!< The jobs waiting to be run.
+            };
+
+
+            /////////////////////////
+            /// Internal workings ///
+            /////////////////////////
+
+            /// <summary> Adds a job to the deque of the calling thread and wakes a sleeping worker. </summary>
+            void push (Job&& job);
+
+            /// <summary> Takes a job from the deque of a thread, or steals one from another thread, then runs it. </summary>
+            /// <returns> Whether a job was found. </returns>
+            bool runOne (const unsigned int thread);
+
+            /// <summary>
+            /// Runs a job, then completes it which may release the jobs waiting on its counter. Exceptions are given to the counter, they're
+            /// discarded if the job has no counter as there's nobody to give them to.
+            /// </summary>
+            void execute (Job& job);
+
+            /// <summary> The loop each worker thread runs until the system is destroyed. </summary>
+            void work (const unsigned int thread);
+
+
+            ///////////////////////////
+            /// Implementation data ///
+            ///////////////////////////
+
+            std::vector<std::unique_ptr<Queue>> m_queues    { };        //!< The deque of each thread, the creator of the system uses the first.
+            std::vector<std::thread>            m_workers   { };        //!< The worker threads, the creator acts as the first thread.
+            std::atomic<unsigned int>           m_queued    { 0 };      //!< The number of jobs waiting in every deque.
+            std::mutex                          m_mutex     { };        //!< Used by sleeping workers.
+            std::condition_variable             m_wake      { };        //!< Wakes the workers when jobs are added or the system is destroyed.
+            std::atomic<bool>                   m_stop      { false };  //!< Tells the workers to exit.
+    };
+}
+
+#endif
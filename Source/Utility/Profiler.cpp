@@ -0,0 +1,269 @@
+#include "Profiler.hpp"
+
+
+// STL headers.
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+// Engine headers.
+#include <Utility/RingBuffer.hpp>
+
+
+// Utility namespace.
+namespace util
+{
+    #if !defined WATER_DISABLE_PROFILER
+
+    /// <summary>
+    /// The zones recorded by a single thread. Only the owner writes, it fills a slot and then publishes it by advancing the head, so
+    /// readers know every slot below the head is complete. Slot i is only reused once the head reaches i + capacity, so a reader which
+    /// sees that head after reading the slot discards it. Every field is atomic so concurrent reading is well defined, relaxed access
+    /// costs nothing.
+    /// </summary>
+    struct ProfileBuffer final
+    {
+        /// <summary> A single recorded zone. </summary>
+        struct Sample final
+        {
+            std::atomic<const char*>    name    { nullptr };    //!< The name of the zone.
+            std::atomic<std::uint64_t>  start   { 0 };          //!< When the zone started in nanoseconds.
+            std::atomic<std::uint64_t>  end     { 0 };          //!< When the zone ended in nanoseconds.
+        };
+
+        ProfileBuffer (const unsigned int capacity, const unsigned int thread)
+            : samples (new Sample[capacity]), capacity (capacity), thread (thread) { }
+
+        std::unique_ptr<Sample[]>   samples     { };    //!< The ring of samples.
+        const unsigned int          capacity    { 0 };  //!< The number of samples the ring holds.
+        const unsigned int          thread      { 0 };  //!< The ID of the owning thread in traces.
+        std::atomic<std::uint64_t>  head        { 0 };  //!< The total number of samples ever recorded.
+    };
+
+
+    // Shared state. The buffers are only ever added to so a pointer to one remains valid for the rest of the program.
+    static std::atomic<bool>                            s_enabled   { false };
+    static std::atomic<unsigned int>                    s_capacity  { 16384 };
+    static std::mutex                                   s_mutex     { };
+    static std::vector<std::unique_ptr<ProfileBuffer>>  s_buffers   { };
+
+    // Frame state, only used by the game loop thread.
+    static RingBuffer<std::uint64_t>                    s_frames    { };
+    static std::uint64_t                                s_lastFrame { 0 };
+    static unsigned int                                 s_hitchSize { 120 };
+    static std::uint64_t                                s_hitch     { 0 };
+    static std::string                                  s_hitchFile = "profile.json";
+    static unsigned int                                 s_cooldown  { 0 };
+
+    // The buffer of the calling thread, created the first time it records a zone.
+    static thread_local ProfileBuffer*                  t_buffer    { nullptr };
+
+
+    /// <summary> Writes a string literal as a JSON string. </summary>
+    static void writeString (std::ostream& stream, const char* string)
+    {
+        stream << '"';
+
+        for (; *string != '\0'; ++string)
+        {
+            if (*string == '"' || *string == '\\')
+            {
+                stream << '\\';
+            }
+
+            stream << *string;
+        }
+
+        stream << '"';
+    }
+
+
+    /////////////////////////
+    /// System management ///
+    /////////////////////////
+
+    void Profiler::initialise (const unsigned int capacity, const unsigned int frames, const float hitch, const std::string& file)
+    {
+        s_capacity.store (std::max (capacity, 1U), std::memory_order_relaxed);
+
+        s_hitchSize = frames;
+        s_hitch     = (std::uint64_t) (std::max (hitch, 0.f) * 1e9f);
+        s_hitchFile = file;
+
+        // Keep more frame starts than a hitch needs so on demand traces can go further back.
+        s_frames.setCapacity (std::max (frames, 1U) * 4);
+
+        setEnabled (true);
+    }
+
+
+    void Profiler::setEnabled (const bool enabled)
+    {
+        s_enabled.store (enabled, std::memory_order_relaxed);
+    }
+
+
+    bool Profiler::isEnabled()
+    {
+        return s_enabled.load (std::memory_order_relaxed);
+    }
+
+
+    //////////////
+    /// Frames ///
+    //////////////
+
+    void Profiler::markFrame()
+    {
+        if (!isEnabled())
+        {
+            s_lastFrame = 0;
+            return;
+        }
+
+        const auto time = now();
+
+        // The previous frame is recorded as a zone so frames stand out in the trace.
+        if (s_lastFrame != 0)
+        {
+            record ("Frame", s_lastFrame, time);
+
+            // A long run of slow frames would otherwise write a trace every frame.
+            if (s_cooldown > 0)
+            {
+                --s_cooldown;
+            }
+
+            else if (s_hitch != 0 && time - s_lastFrame > s_hitch)
+            {
+                dump (s_hitchFile, s_hitchSize);
+                s_cooldown = s_hitchSize;
+            }
+        }
+
+        s_frames.push (time);
+        s_lastFrame = time;
+    }
+
+
+    ///////////////
+    /// Tracing ///
+    ///////////////
+
+    bool Profiler::dump (const std::string& file, const unsigned int frames)
+    {
+        // Zones which started before the oldest frame requested are left out.
+        const auto kept     = s_frames.size();
+        const auto cutoff   = frames != 0 && kept != 0 ? s_frames[kept > frames ? kept - frames : 0] : 0;
+
+        std::ofstream stream { file, std::ios::out | std::ios::trunc };
+
+        if (!stream.is_open())
+        {
+            return false;
+        }
+
+        // Copy the list so threads can register whilst we write.
+        auto buffers = std::vector<ProfileBuffer*> { };
+
+        {
+            std::lock_guard<std::mutex> lock { s_mutex };
+
+            for (const auto& buffer : s_buffers)
+            {
+                buffers.push_back (buffer.get());
+            }
+        }
+
+        stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        stream.setf (std::ios::fixed);
+        stream.precision (3);
+
+        auto first = true;
+
+        for (const auto buffer : buffers)
+        {
+            // Name each thread so the trace is easier to follow.
+            stream  << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->thread
+                    << ",\"args\":{\"name\":\"Thread " << buffer->thread << "\"}}";
+
+            first = false;
+
+            // Only slots below the head have been published.
+            const auto head     = buffer->head.load (std::memory_order_acquire);
+            const auto oldest   = head > buffer->capacity ? head - buffer->capacity : 0;
+
+            for (auto i = oldest; i < head; ++i)
+            {
+                const auto& sample  = buffer->samples[i % buffer->capacity];
+                const auto  name    = sample.name.load (std::memory_order_relaxed);
+                const auto  start   = sample.start.load (std::memory_order_relaxed);
+                const auto  end     = sample.end.load (std::memory_order_relaxed);
+
+                // The owner may have lapped us whilst we read the sample.
+                std::atomic_thread_fence (std::memory_order_acquire);
+                const auto current = buffer->head.load (std::memory_order_relaxed);
+
+                if (current - i >= buffer->capacity || start < cutoff || !name)
+                {
+                    continue;
+                }
+
+                stream << ",\n{\"name\":";
+                writeString (stream, name);
+                stream  << ",\"cat\":\"water\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread
+                        << ",\"ts\":" << start / 1000.0 << ",\"dur\":" << (end - start) / 1000.0 << "}";
+            }
+        }
+
+        stream << "\n]}\n";
+
+        return stream.good();
+    }
+
+
+    /////////////////////////
+    /// Internal workings ///
+    /////////////////////////
+
+    void Profiler::record (const char* const name, const std::uint64_t start, const std::uint64_t end)
+    {
+        // Registering is the only time a zone takes a lock.
+        if (!t_buffer)
+        {
+            std::lock_guard<std::mutex> lock { s_mutex };
+
+            const auto capacity = s_capacity.load (std::memory_order_relaxed);
+            s_buffers.emplace_back (new ProfileBuffer (capacity, (unsigned int) s_buffers.size()));
+            t_buffer = s_buffers.back().get();
+        }
+
+        auto&       buffer  = *t_buffer;
+        const auto  head    = buffer.head.load (std::memory_order_relaxed);
+        auto&       sample  = buffer.samples[head % buffer.capacity];
+
+        // Readers which see any of the new values must also see the head which reused the slot.
+        std::atomic_thread_fence (std::memory_order_release);
+
+        sample.name.store (name, std::memory_order_relaxed);
+        sample.start.store (start, std::memory_order_relaxed);
+        sample.end.store (end, std::memory_order_relaxed);
+
+        buffer.head.store (head + 1, std::memory_order_release);
+    }
+
+    #else
+
+    void Profiler::initialise (const unsigned int, const unsigned int, const float, const std::string&) { }
+    void Profiler::setEnabled (const bool) { }
+    bool Profiler::isEnabled() { return false; }
+    void Profiler::markFrame() { }
+    bool Profiler::dump (const std::string&, const unsigned int) { return false; }
+    void Profiler::record (const char* const, const std::uint64_t, const std::uint64_t) { }
+
+    #endif
+}
@@ -0,0 +1,130 @@
+#if !defined WATER_UTILITY_PROFILER_INCLUDED
+#define WATER_UTILITY_PROFILER_INCLUDED
+
+
+// STL headers.
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+
+// Profiling macros. Defining WATER_DISABLE_PROFILER removes every zone and frame mark from the build.
+#if !defined WATER_DISABLE_PROFILER
+    #define WATER_PROFILE_CONCATENATE_IMPL(a, b)    a##b
+    #define WATER_PROFILE_CONCATENATE(a, b)         WATER_PROFILE_CONCATENATE_IMPL (a, b)
+
+    /// <summary> Times the rest of the enclosing scope, the name must be a string literal. </summary>
+    #define WATER_PROFILE_ZONE(name)                const util::ProfileZone WATER_PROFILE_CONCATENATE (profileZone, __LINE__) { name }
+
+    /// <summary> Marks the start of a new frame, this must only be used by the thread which runs the game loop. </summary>
+    #define WATER_PROFILE_FRAME()                   util::Profiler::markFrame()
+#else
+    #define WATER_PROFILE_ZONE(name)
+    #define WATER_PROFILE_FRAME()
+#endif
+
+
+// Utility namespace.
+namespace util
+{
+    /// <summary>
+    /// A low overhead recorder of timed zones which can be written out in the Chrome trace_event format, viewable in chrome://tracing
+    /// or Perfetto. Each thread records into its own fixed size ring buffer which only that thread writes to, so recording a zone never
+    /// locks or allocates once the buffer exists. Writing a trace reads every buffer without stopping the threads, samples which were
+    /// overwritten whilst being read are discarded.
+    ///
+    /// The game loop marks each frame so the trace can be limited to the most recent frames. A trace can be written at any time from
+    /// the game loop thread, or automatically when a frame takes longer than a threshold. Buffers are created the first time a thread
+    /// records a zone and kept until the program ends, so threads should be long-lived.
+    /// </summary>
+    class Profiler final
+    {
+        public:
+
+            Profiler()  = delete;
+            ~Profiler() = delete;
+
+
+            /////////////////////////
+            /// System management ///
+            /////////////////////////
+
+            /// <summary> Enables recording. The capacity only applies to buffers created afterwards. </summary>
+            /// <param name="capacity"> How many zones each thread keeps before its oldest are overwritten. </param>
+            /// <param name="frames"> How many of the most recent frames a trace written because of a hitch contains. </param>
+            /// <param name="hitch"> How many seconds a frame may take before a trace is written, zero disables this. </param>
+            /// <param name="file"> Where traces written because of a hitch are saved. </param>
+            static void initialise (const unsigned int capacity, const unsigned int frames, const float hitch, const std::string& file);
+
+            /// <summary> Starts or stops recording, zones which begin whilst disabled are ignored. </summary>
+            static void setEnabled (const bool enabled);
+
+            /// <summary> Indicates whether zones are currently being recorded. </summary>
+            static bool isEnabled();
+
+
+            //////////////
+            /// Frames ///
+            //////////////
+
+            /// <summary> Marks the start of a frame and writes a trace if the previous frame took too long. Use WATER_PROFILE_FRAME(). </summary>
+            static void markFrame();
+
+
+            ///////////////
+            /// Tracing ///
+            ///////////////
+
+            /// <summary> Writes the zones of the most recent frames to a file as Chrome trace_event JSON. </summary>
+            /// <param name="file"> Where to save the trace. </param>
+            /// <param name="frames"> How many of the most recent frames to include, zero includes every zone still kept. </param>
+            /// <returns> Whether the file could be written. </returns>
+            static bool dump (const std::string& file, const unsigned int frames = 0);
+
+
+            /////////////////////////
+            /// Internal workings ///
+            /////////////////////////
+
+            /// <summary> Obtains the time which zones are measured with, in nanoseconds. </summary>
+            static std::uint64_t now()
+            {
+                return (std::uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds> (
+                    std::chrono::steady_clock::now().time_since_epoch()).count();
+            }
+
+            /// <summary> Records a finished zone into the buffer of the calling thread. Use WATER_PROFILE_ZONE(). </summary>
+            static void record (const char* const name, const std::uint64_t start, const std::uint64_t end);
+    };
+
+
+    /// <summary> Records the time between its construction and destruction as a zone. Use WATER_PROFILE_ZONE(). </summary>
+    class ProfileZone final
+    {
+        public:
+
+            /// <summary> Starts timing if the profiler is enabled. </summary>
+            /// <param name="name"> The name of the zone, it must outlive the program so should be a string literal. </param>
+            ProfileZone (const char* const name)
+                : m_name (name), m_start (Profiler::isEnabled() ? Profiler::now() : 0) { }
+
+            /// <summary> Records the zone if it was started. </summary>
+            ~ProfileZone()
+            {
+                if (m_start != 0)
+                {
+                    Profiler::record (m_name, m_start, Profiler::now());
+                }
+            }
+
+            ProfileZone (const ProfileZone& copy)               = delete;
+            ProfileZone& operator= (const ProfileZone& copy)    = delete;
+
+        private:
+
+            const char*     m_name  { nullptr };    //!< The name of the zone.
+            std::uint64_t   m_start { 0 };          //!< When the zone started, zero if it isn't being recorded.
+    };
+}
+
+#endif
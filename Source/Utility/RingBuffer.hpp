@@ -0,0 +1,141 @@
+#if !defined WATER_UTILITY_RING_BUFFER_INCLUDED
+#define WATER_UTILITY_RING_BUFFER_INCLUDED
+
+
+// STL headers.
+#include <utility>
+#include <vector>
+
+
+// Utility namespace.
+namespace util
+{
+    template <typename T>
+    /// <summary>
+    /// A fixed capacity container which keeps the most recent values pushed to it. Once full each push overwrites the oldest value,
+    /// so recording a value never allocates. Values are indexed from the oldest to the newest.
+    /// </summary>
+    class RingBuffer final
+    {
+        public:
+
+            ///////////////////////////////////
+            /// Constructors and destructor ///
+            ///////////////////////////////////
+
+            RingBuffer()                                    = default;
+            RingBuffer (const RingBuffer& copy)             = default;
+            RingBuffer& operator= (const RingBuffer& copy)  = default;
+            ~RingBuffer()                                   = default;
+
+            RingBuffer (RingBuffer&& move)                  { *this = std::move (move); }
+            RingBuffer& operator= (RingBuffer&& move);
+
+
+            /////////////////
+            /// Operators ///
+            /////////////////
+
+            /// <summary> Obtains a value, zero is the oldest value kept. Must be lower than size(). </summary>
+            const T& operator[] (const unsigned int index) const    { return m_values[(m_start + index) % m_values.size()]; }
+
+
+            ///////////////////////////
+            /// Getters and setters ///
+            ///////////////////////////
+
+            /// <summary> Obtains the number of values kept. </summary>
+            unsigned int size() const                               { return m_size; }
+
+            /// <summary> Obtains the number of values which can be kept before the oldest are overwritten. </summary>
+            unsigned int getCapacity() const                        { return (unsigned int) m_values.size(); }
+
+            /// <summary> Indicates whether no values are kept. </summary>
+            bool isEmpty() const                                    { return m_size == 0; }
+
+            /// <summary> Obtains the newest value. The buffer must not be empty. </summary>
+            const T& back() const                                   { return (*this)[m_size - 1]; }
+
+
+            ///////////////////////
+            /// Data management ///
+            ///////////////////////
+
+            /// <summary> Changes how many values can be kept, every value currently kept is discarded. </summary>
+            /// <param name="capacity"> The number of values to keep, zero stops values from being kept at all. </param>
+            void setCapacity (const unsigned int capacity);
+
+            /// <summary> Adds a value, overwriting the oldest value if the buffer is full. Does nothing without any capacity. </summary>
+            void push (const T& value);
+
+            /// <summary> Discards every value, the capacity is maintained. </summary>
+            void clear()                                            { m_start = 0; m_size = 0; }
+
+        private:
+
+            ///////////////////////////
+            /// Implementation data ///
+            ///////////////////////////
+
+            std::vector<T>  m_values    { };    //!< The storage of every value, its size is the capacity.
+            unsigned int    m_start     { 0 };  //!< The index of the oldest value.
+            unsigned int    m_size      { 0 };  //!< The number of values kept.
+    };
+
+
+    ////////////////////
+    /// Constructors ///
+    ////////////////////
+
+    template <typename T> RingBuffer<T>& RingBuffer<T>::operator= (RingBuffer&& move)
+    {
+        if (this != &move)
+        {
+            m_values    = std::move (move.m_values);
+            m_start     = move.m_start;
+            m_size      = move.m_size;
+
+            // Reset primitives.
+            move.m_start    = 0;
+            move.m_size     = 0;
+        }
+
+        return *this;
+    }
+
+
+    ///////////////////////
+    /// Data management ///
+    ///////////////////////
+
+    template <typename T> void RingBuffer<T>::setCapacity (const unsigned int capacity)
+    {
+        m_values.assign (capacity, T { });
+        clear();
+    }
+
+
+    template <typename T> void RingBuffer<T>::push (const T& value)
+    {
+        const auto capacity = (unsigned int) m_values.size();
+
+        // Pre-condition: There is somewhere to put the value.
+        if (capacity == 0)
+        {
+            return;
+        }
+
+        if (m_size < capacity)
+        {
+            m_values[(m_start + m_size++) % capacity] = value;
+        }
+
+        else
+        {
+            m_values[m_start] = value;
+            m_start = (m_start + 1) % capacity;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,230 @@
+#if !defined WATER_UTILITY_SLOT_MAP_INCLUDED
+#define WATER_UTILITY_SLOT_MAP_INCLUDED
+
+
+// STL headers.
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+// Utility namespace.
+namespace util
+{
+    /// <summary>
+    /// Identifies a value stored in a SlotMap. The generation changes every time the slot is reused so handles to erased values are
+    /// detected rather than silently referring to whatever replaced them. Default constructed handles never refer to anything.
+    /// </summary>
+    struct SlotHandle final
+    {
+        std::uint32_t   index       { ~0U };    //!< The slot which the value was stored in.
+        std::uint32_t   generation  { 0 };      //!< The generation of the slot when the value was stored.
+
+        bool operator== (const SlotHandle& rhs) const   { return index == rhs.index && generation == rhs.generation; }
+        bool operator!= (const SlotHandle& rhs) const   { return !(*this == rhs); }
+    };
+
+
+    template <typename T>
+    /// <summary>
+    /// A container which gives each value a stable handle while keeping every value packed in a contiguous array. Inserting, erasing
+    /// and looking up values are all constant time. Erasing moves the last value into the gap so the order of values isn't maintained.
+    /// </summary>
+    class SlotMap final
+    {
+        public:
+
+            ///////////////////////////////////
+            /// Constructors and destructor ///
+            ///////////////////////////////////
+
+            SlotMap()                                   = default;
+            SlotMap (const SlotMap& copy)               = default;
+            SlotMap& operator= (const SlotMap& copy)    = default;
+            ~SlotMap()                                  = default;
+
+            SlotMap (SlotMap&& move)                    { *this = std::move (move); }
+            SlotMap& operator= (SlotMap&& move);
+
+
+            ///////////////////////////
+            /// Getters and setters ///
+            ///////////////////////////
+
+            /// <summary> Obtains the number of values stored. </summary>
+            unsigned int size() const                   { return (unsigned int) m_values.size(); }
+
+            /// <summary> Indicates whether no values are stored. </summary>
+            bool isEmpty() const                        { return m_values.empty(); }
+
+            /// <summary> Obtains every value stored, packed together in no particular order. </summary>
+            const std::vector<T>& getValues() const     { return m_values; }
+
+            /// <summary> Checks whether a handle refers to a value which is still stored. </summary>
+            bool contains (const SlotHandle handle) const;
+
+            /// <summary> Finds the value a handle refers to. </summary>
+            /// <returns> The value, nullptr if the handle is stale or was never valid. </returns>
+            T* find (const SlotHandle handle)               { return contains (handle) ? &m_values[m_slots[handle.index].value] : nullptr; }
+
+            /// <summary> Finds the value a handle refers to. </summary>
+            /// <returns> The value, nullptr if the handle is stale or was never valid. </returns>
+            const T* find (const SlotHandle handle) const   { return contains (handle) ? &m_values[m_slots[handle.index].value] : nullptr; }
+
+
+            ///////////////////////
+            /// Data management ///
+            ///////////////////////
+
+            /// <summary> Reserves enough memory for the given number of values. </summary>
+            void reserve (const unsigned int capacity);
+
+            /// <summary> Stores a value, reusing an erased slot when possible. </summary>
+            /// <returns> The handle of the value. </returns>
+            SlotHandle insert (const T& value);
+
+            /// <summary> Erases the value a handle refers to, the handle and any copies of it will become stale. </summary>
+            /// <returns> Whether the handle referred to a value. </returns>
+            bool erase (const SlotHandle handle);
+
+            /// <summary> Erases every value, every handle will become stale. Reserved memory is maintained. </summary>
+            void clear();
+
+        private:
+
+            /// <summary> The indirection between a handle and its value. </summary>
+            struct Slot final
+            {
+                std::uint32_t   value       { 0 };  //!< The index of the value, or the next free slot when unused.
+                std::uint32_t   generation  { 0 };  //!< Incremented every time the value in the slot is erased.
+            };
+
+
+            ///////////////////////////
+            /// Implementation data ///
+            ///////////////////////////
+
+            std::vector<T>              m_values    { };        //!< Every value stored, packed together.
+            std::vector<std::uint32_t>  m_owners    { };        //!< The slot of each value, used to fix the slot of a value when it is moved.
+            std::vector<Slot>           m_slots     { };        //!< Every slot which has been used, occupied or not.
+            std::uint32_t               m_free      { ~0U };    //!< The most recently freed slot, each free slot leads to the next.
+    };
+
+
+    ////////////////////
+    /// Constructors ///
+    ////////////////////
+
+    template <typename T> SlotMap<T>& SlotMap<T>::operator= (SlotMap&& move)
+    {
+        if (this != &move)
+        {
+            m_values    = std::move (move.m_values);
+            m_owners    = std::move (move.m_owners);
+            m_slots     = std::move (move.m_slots);
+            m_free      = move.m_free;
+
+            // Reset primitives.
+            move.m_free = ~0U;
+        }
+
+        return *this;
+    }
+
+
+    ///////////////////////////
+    /// Getters and setters ///
+    ///////////////////////////
+
+    template <typename T> bool SlotMap<T>::contains (const SlotHandle handle) const
+    {
+        // Erased slots have already moved on to the next generation.
+        return handle.index < m_slots.size() && m_slots[handle.index].generation == handle.generation;
+    }
+
+
+    ///////////////////////
+    /// Data management ///
+    ///////////////////////
+
+    template <typename T> void SlotMap<T>::reserve (const unsigned int capacity)
+    {
+        m_values.reserve (capacity);
+        m_owners.reserve (capacity);
+        m_slots.reserve (capacity);
+    }
+
+
+    template <typename T> SlotHandle SlotMap<T>::insert (const T& value)
+    {
+        auto index = m_free;
+
+        if (index != ~0U)
+        {
+            m_free = m_slots[index].value;
+        }
+
+        else
+        {
+            index = (std::uint32_t) m_slots.size();
+            m_slots.emplace_back();
+        }
+
+        auto& slot  = m_slots[index];
+        slot.value  = (std::uint32_t) m_values.size();
+
+        m_values.push_back (value);
+        m_owners.push_back (index);
+
+        return { index, slot.generation };
+    }
+
+
+    template <typename T> bool SlotMap<T>::erase (const SlotHandle handle)
+    {
+        // Pre-condition: The handle refers to a value.
+        if (!contains (handle))
+        {
+            return false;
+        }
+
+        // Swap and pop, the slot of the value moved into the gap must follow it.
+        auto&       slot    = m_slots[handle.index];
+        const auto  gap     = slot.value;
+        const auto  last    = (std::uint32_t) m_values.size() - 1;
+
+        if (gap != last)
+        {
+            m_values[gap]                   = std::move (m_values[last]);
+            m_owners[gap]                   = m_owners[last];
+            m_slots[m_owners[gap]].value    = gap;
+        }
+
+        m_values.pop_back();
+        m_owners.pop_back();
+
+        ++slot.generation;
+        slot.value  = m_free;
+        m_free      = handle.index;
+
+        return true;
+    }
+
+
+    template <typename T> void SlotMap<T>::clear()
+    {
+        for (const auto index : m_owners)
+        {
+            auto& slot = m_slots[index];
+
+            ++slot.generation;
+            slot.value  = m_free;
+            m_free      = index;
+        }
+
+        m_values.clear();
+        m_owners.clear();
+    }
+}
+
+#endif
@@ -0,0 +1,159 @@
+#include "ThreadPool.hpp"
+
+
+// Utility namespace.
+namespace util
+{
+    ///////////////////////////////////
+    /// Constructors and destructor ///
+    ///////////////////////////////////
+
+    ThreadPool::ThreadPool (const unsigned int threads)
+    {
+        // The hardware may not be able to tell us how many threads it supports.
+        auto total = threads != 0 ? threads : std::thread::hardware_concurrency();
+
+        if (total == 0)
+        {
+            total = 1;
+        }
+
+        // The caller of run() is the first thread so only the rest need creating.
+        m_workers.reserve (total - 1);
+
+        for (auto i = 1U; i < total; ++i)
+        {
+            m_workers.emplace_back (&ThreadPool::work, this, i);
+        }
+    }
+
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock { m_mutex };
+            m_stop = true;
+        }
+
+        m_start.notify_all();
+
+        for (auto& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+
+    ///////////////
+    /// Running ///
+    ///////////////
+
+    void ThreadPool::run (const unsigned int count, const Task& task)
+    {
+        // Pre-condition: There's work to do.
+        if (count == 0)
+        {
+            return;
+        }
+
+        // Avoid the cost of waking the workers if they can't help.
+        if (m_workers.empty() || count == 1)
+        {
+            for (auto i = 0U; i < count; ++i)
+            {
+                task (i, 0);
+            }
+
+            return;
+        }
+
+        // Publish the batch and wake the workers.
+        {
+            std::lock_guard<std::mutex> lock { m_mutex };
+            m_task  = &task;
+            m_count = count;
+            m_next  = 0;
+            m_busy  = (unsigned int) m_workers.size();
+            ++m_batch;
+        }
+
+        m_start.notify_all();
+
+        // Help out, then wait for every worker to leave the batch so the task can't be used after we return. This must happen even
+        // if a task throws, so exceptions are only rethrown once the batch is over.
+        process (0);
+
+        std::unique_lock<std::mutex> lock { m_mutex };
+        m_finish.wait (lock, [this] { return m_busy == 0; });
+        m_task = nullptr;
+
+        if (m_error)
+        {
+            auto error = m_error;
+            m_error = nullptr;
+            std::rethrow_exception (error);
+        }
+    }
+
+
+    /////////////////////////
+    /// Internal workings ///
+    /////////////////////////
+
+    void ThreadPool::work (const unsigned int thread)
+    {
+        auto batch = 0U;
+
+        while (true)
+        {
+            // Sleep until there's a new batch or the pool is being destroyed.
+            {
+                std::unique_lock<std::mutex> lock { m_mutex };
+                m_start.wait (lock, [&] { return m_stop || m_batch != batch; });
+
+                if (m_stop)
+                {
+                    return;
+                }
+
+                batch = m_batch;
+            }
+
+            process (thread);
+
+            // Let the caller know when the last worker has finished.
+            std::lock_guard<std::mutex> lock { m_mutex };
+
+            if (--m_busy == 0)
+            {
+                m_finish.notify_one();
+            }
+        }
+    }
+
+
+    void ThreadPool::process (const unsigned int thread)
+    {
+        // Tasks are claimed one at a time so threads which finish early take on more work.
+        for (auto task = m_next++; task < m_count; task = m_next++)
+        {
+            try
+            {
+                (*m_task) (task, thread);
+            }
+
+            // Claim every remaining task so the batch ends as soon as possible.
+            catch (...)
+            {
+                m_next = m_count;
+
+                std::lock_guard<std::mutex> lock { m_mutex };
+
+                if (!m_error)
+                {
+                    m_error = std::current_exception();
+                }
+            }
+        }
+    }
+}
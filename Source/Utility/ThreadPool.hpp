@@ -0,0 +1,99 @@
+#if !defined WATER_UTILITY_THREAD_POOL_INCLUDED
+#define WATER_UTILITY_THREAD_POOL_INCLUDED
+
+
+// STL headers.
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// Utility namespace.
+namespace util
+{
+    /// <summary>
+    /// A fixed set of worker threads which cooperate with the calling thread to process batches of tasks. A batch is started with run()
+    /// which blocks until every task has completed, tasks are claimed dynamically so uneven workloads are balanced automatically. If a
+    /// task throws, no more tasks are started and run() rethrows the first exception once every thread has left the batch.
+    /// </summary>
+    class ThreadPool final
+    {
+        public:
+
+            /// <summary> The function type of a task, given the index of the task and the index of the thread running it. </summary>
+            using Task = std::function<void (const unsigned int task, const unsigned int thread)>;
+
+
+            ///////////////////////////////////
+            /// Constructors and destructor ///
+            ///////////////////////////////////
+
+            /// <summary> Creates the pool, starting its worker threads. </summary>
+            /// <param name="threads"> The total number of threads including the caller of run(), zero will use every hardware thread. </param>
+            ThreadPool (const unsigned int threads = 1);
+
+            /// <summary> Stops and joins every worker thread. </summary>
+            ~ThreadPool();
+
+            ThreadPool (const ThreadPool& copy)             = delete;
+            ThreadPool& operator= (const ThreadPool& copy)  = delete;
+            ThreadPool (ThreadPool&& move)                  = delete;
+            ThreadPool& operator= (ThreadPool&& move)       = delete;
+
+
+            ///////////////////////////
+            /// Getters and setters ///
+            ///////////////////////////
+
+            /// <summary> Obtains the total number of threads which run tasks, including the caller of run(). </summary>
+            unsigned int getThreadCount() const     { return (unsigned int) m_workers.size() + 1; }
+
+
+            ///////////////
+            /// Running ///
+            ///////////////
+
+            /// <summary>
+            /// Runs a batch of tasks across every thread, blocking until they have all completed. This isn't re-entrant. If a task throws,
+            /// tasks which haven't started are skipped and the first exception is rethrown after every thread has stopped using the task.
+            /// </summary>
+            /// <param name="count"> The number of tasks to run. </param>
+            /// <param name="task"> The function to call for each task, thread indices range from zero to getThreadCount() - 1. </param>
+            void run (const unsigned int count, const Task& task);
+
+        private:
+
+            /////////////////////////
+            /// Internal workings ///
+            /////////////////////////
+
+            /// <summary> The loop each worker thread runs until the pool is destroyed. </summary>
+            void work (const unsigned int thread);
+
+            /// <summary> Claims and runs tasks from the current batch until there are none left, keeping the first exception thrown. </summary>
+            void process (const unsigned int thread);
+
+
+            ///////////////////////////
+            /// Implementation data ///
+            ///////////////////////////
+
+            std::vector<std::thread>    m_workers   { };          //!< The worker threads, the caller of run() acts as an extra thread.
+            std::mutex                  m_mutex     { };          //!< Protects the batch state shared with the workers.
+            std::condition_variable     m_start     { };          //!< Wakes the workers when a batch starts or the pool is destroyed.
+            std::condition_variable     m_finish    { };          //!< Wakes the caller of run() when the workers have left the batch.
+            const Task*                 m_task      { nullptr };  //!< The function of the current batch.
+            unsigned int                m_count     { 0 };        //!< The number of tasks in the current batch.
+            std::atomic<unsigned int>   m_next      { 0 };        //!< The next unclaimed task of the current batch.
+            unsigned int                m_batch     { 0 };        //!< Incremented every batch so workers know when there's new work.
+            unsigned int                m_busy      { 0 };        //!< The number of workers still processing the current batch.
+            std::exception_ptr          m_error     { };          //!< The first exception thrown by a task of the current batch.
+            bool                        m_stop      { false };    //!< Tells the workers to exit.
+    };
+}
+
+#endif